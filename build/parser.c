@@ -0,0 +1,2695 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "parser.bison"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unordered_set>
+#include <cmath>
+#include <Expression.hpp>
+#include <ParseContext.hpp>
+
+#define YYSTYPE Expression*
+
+extern int yylex(Expression** value, ParseContext* context);
+extern char* yyget_text(yyscan_t scanner);
+int yyerror(ParseContext* context, const char*);
+
+static void runStatement(ParseContext* context, Expression* statement)
+{
+    // Every node still tracked belongs to this statement, the handler owns it from here.
+    // Swapping drops the buckets too, clear() would keep them after a large literal
+    std::unordered_set<Expression*>{}.swap(context->pointers);
+    context->statement_handler(statement);
+}
+
+// Value of a numeric constant (optionally negated) exactly as evaluation would produce it
+static bool numericConstant(Expression* e, double& value)
+{
+    auto negation = dynamic_cast<Negation*>(e);
+    auto number = dynamic_cast<Number*>((negation != nullptr) ? negation->getExpression() : e);
+    if (number == nullptr)
+    {
+        return false;
+    }
+    value = (std::abs(number->getNumber()) <= 0.0000000001) ? 0.0 : number->getNumber();
+    if (negation != nullptr)
+    {
+        value = -1 * value;
+    }
+    return true;
+}
+
+static void releaseConstant(ParseContext* context, Expression* e)
+{
+    if (auto negation = dynamic_cast<Negation*>(e))
+    {
+        context->pointers.erase(negation->getExpression());
+    }
+    context->pointers.erase(e);
+    e->destroy();
+    delete e;
+}
+
+static Expression* numberNode(ParseContext* context, double value)
+{
+    // A negative zero only comes from negating a literal zero, keep it that way
+    if (value == 0.0 && std::signbit(value))
+    {
+        Expression* zero = new Number(0.0);
+        Expression* e = new Negation(zero);
+        context->pointers.emplace(zero);
+        context->pointers.emplace(e);
+        return e;
+    }
+    Expression* e = new Number(value);
+    context->pointers.emplace(e);
+    return e;
+}
+
+static Expression* rowVector(ParseContext* context, const NumberList* numbers, size_t row)
+{
+    std::vector<Expression*> exprs{};
+    exprs.reserve(numbers->getColumns());
+    for (size_t j = 0; j < numbers->getColumns(); ++j)
+    {
+        exprs.push_back(numberNode(context, numbers->getValues()[row * numbers->getColumns() + j]));
+    }
+    Expression* e = new Vector(exprs);
+    context->pointers.emplace(e);
+    return e;
+}
+
+// Generic nodes of a numeric literal, built once a non constant element shows up
+static ExpressionList* expandNumbers(ParseContext* context, NumberList* numbers)
+{
+    ExpressionList* list = new ExpressionList();
+    for (double value : numbers->getValues())
+    {
+        list->addExpressionBack(numberNode(context, value));
+    }
+    context->pointers.erase(numbers);
+    delete numbers;
+    context->pointers.emplace(list);
+    return list;
+}
+
+static ExpressionList* expandRows(ParseContext* context, NumberList* numbers)
+{
+    ExpressionList* list = new ExpressionList();
+    for (size_t i = 0; i < numbers->getRows(); ++i)
+    {
+        list->addExpressionBack(rowVector(context, numbers, i));
+    }
+    context->pointers.erase(numbers);
+    delete numbers;
+    context->pointers.emplace(list);
+    return list;
+}
+
+static Expression* vectorFromList(ParseContext* context, Expression* elements)
+{
+    std::vector<Expression*> exprs{};
+    ExpressionList* list = dynamic_cast<ExpressionList*>(elements);
+    if (NumberList* numbers = dynamic_cast<NumberList*>(elements))
+    {
+        // The nodes go straight into the Vector, without an ExpressionList in between
+        exprs.reserve(numbers->getValues().size());
+        context->pointers.reserve(context->pointers.size() + numbers->getValues().size());
+        for (double value : numbers->getValues())
+        {
+            exprs.push_back(numberNode(context, value));
+        }
+        context->pointers.erase(numbers);
+        delete numbers;
+    }
+    else if (list)
+    {
+        exprs = list->getVectorExpression();
+        if (context->pointers.find(list) != context->pointers.end())
+        {
+            context->pointers.erase(list);
+        }
+        delete list;
+    }
+    else
+    {
+        exprs.push_back(elements);
+    }
+    Expression* e = new Vector(exprs);
+    context->pointers.emplace(e);
+    return e;
+}
+
+static Expression* matrixFromList(ParseContext* context, Expression* rows)
+{
+    std::vector<Expression*> matrix{};
+    ExpressionList* list = dynamic_cast<ExpressionList*>(rows);
+    if (list)
+    {
+        for (auto expr : list->getVectorExpression())
+        {
+            Vector* vec = dynamic_cast<Vector*>(expr);
+            if (vec)
+            {
+                matrix.push_back(vec);
+            }
+            else
+            {
+                Name* name = dynamic_cast<Name*>(expr);
+                if (name)
+                {
+                    matrix.push_back(name);
+                }
+            }
+        }
+    }
+    if (context->pointers.find(rows) != context->pointers.end())
+    {
+        context->pointers.erase(rows);
+    }
+    delete rows;
+    Expression* e = new Matrix(matrix);
+    context->pointers.emplace(e);
+    return e;
+}
+
+static Expression* denseMatrix(ParseContext* context, NumberList* numbers)
+{
+    Expression* e = numbers->toMatrix();
+    context->pointers.erase(numbers);
+    delete numbers;
+    context->pointers.emplace(e);
+    return e;
+}
+
+#line 255 "build/parser.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "token.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_TOKEN_PRINT = 3,                /* TOKEN_PRINT  */
+  YYSYMBOL_TOKEN_DISPLAY = 4,              /* TOKEN_DISPLAY  */
+  YYSYMBOL_TOKEN_LPAREN = 5,               /* TOKEN_LPAREN  */
+  YYSYMBOL_TOKEN_RPAREN = 6,               /* TOKEN_RPAREN  */
+  YYSYMBOL_TOKEN_LBRACKET = 7,             /* TOKEN_LBRACKET  */
+  YYSYMBOL_TOKEN_RBRACKET = 8,             /* TOKEN_RBRACKET  */
+  YYSYMBOL_TOKEN_LBRACE = 9,               /* TOKEN_LBRACE  */
+  YYSYMBOL_TOKEN_RBRACE = 10,              /* TOKEN_RBRACE  */
+  YYSYMBOL_TOKEN_COMMA = 11,               /* TOKEN_COMMA  */
+  YYSYMBOL_TOKEN_SEMICOLON = 12,           /* TOKEN_SEMICOLON  */
+  YYSYMBOL_TOKEN_ASSIGN = 13,              /* TOKEN_ASSIGN  */
+  YYSYMBOL_TOKEN_NUMBER = 14,              /* TOKEN_NUMBER  */
+  YYSYMBOL_TOKEN_IDENTIFIER = 15,          /* TOKEN_IDENTIFIER  */
+  YYSYMBOL_TOKEN_ADD = 16,                 /* TOKEN_ADD  */
+  YYSYMBOL_TOKEN_SUBSTRACT = 17,           /* TOKEN_SUBSTRACT  */
+  YYSYMBOL_TOKEN_MULTIPLY = 18,            /* TOKEN_MULTIPLY  */
+  YYSYMBOL_TOKEN_DIVIDE = 19,              /* TOKEN_DIVIDE  */
+  YYSYMBOL_TOKEN_POW = 20,                 /* TOKEN_POW  */
+  YYSYMBOL_TOKEN_LOG = 21,                 /* TOKEN_LOG  */
+  YYSYMBOL_TOKEN_LN = 22,                  /* TOKEN_LN  */
+  YYSYMBOL_TOKEN_SQRT = 23,                /* TOKEN_SQRT  */
+  YYSYMBOL_TOKEN_ROOT = 24,                /* TOKEN_ROOT  */
+  YYSYMBOL_TOKEN_SIN = 25,                 /* TOKEN_SIN  */
+  YYSYMBOL_TOKEN_COS = 26,                 /* TOKEN_COS  */
+  YYSYMBOL_TOKEN_TAN = 27,                 /* TOKEN_TAN  */
+  YYSYMBOL_TOKEN_CTG = 28,                 /* TOKEN_CTG  */
+  YYSYMBOL_TOKEN_INVERSE = 29,             /* TOKEN_INVERSE  */
+  YYSYMBOL_TOKEN_MATRIXLU = 30,            /* TOKEN_MATRIXLU  */
+  YYSYMBOL_TOKEN_TRIDIAGONAL = 31,         /* TOKEN_TRIDIAGONAL  */
+  YYSYMBOL_TOKEN_REALEIGENVALUES = 32,     /* TOKEN_REALEIGENVALUES  */
+  YYSYMBOL_TOKEN_DETERMINANT = 33,         /* TOKEN_DETERMINANT  */
+  YYSYMBOL_TOKEN_BISECTIONROOT = 34,       /* TOKEN_BISECTIONROOT  */
+  YYSYMBOL_TOKEN_PI = 35,                  /* TOKEN_PI  */
+  YYSYMBOL_TOKEN_EULER = 36,               /* TOKEN_EULER  */
+  YYSYMBOL_TOKEN_INTEGRAL = 37,            /* TOKEN_INTEGRAL  */
+  YYSYMBOL_TOKEN_ODEFIRST = 38,            /* TOKEN_ODEFIRST  */
+  YYSYMBOL_TOKEN_INTERPOLATE = 39,         /* TOKEN_INTERPOLATE  */
+  YYSYMBOL_TOKEN_STRING = 40,              /* TOKEN_STRING  */
+  YYSYMBOL_TOKEN_DERIVATIVE = 41,          /* TOKEN_DERIVATIVE  */
+  YYSYMBOL_TOKEN_FINDROOT = 42,            /* TOKEN_FINDROOT  */
+  YYSYMBOL_TOKEN_ALLROOTS = 43,            /* TOKEN_ALLROOTS  */
+  YYSYMBOL_TOKEN_SPLINE = 44,              /* TOKEN_SPLINE  */
+  YYSYMBOL_TOKEN_POINTS = 45,              /* TOKEN_POINTS  */
+  YYSYMBOL_TOKEN_LOADCSV = 46,             /* TOKEN_LOADCSV  */
+  YYSYMBOL_TOKEN_LOADNPY = 47,             /* TOKEN_LOADNPY  */
+  YYSYMBOL_TOKEN_SAVENPY = 48,             /* TOKEN_SAVENPY  */
+  YYSYMBOL_YYACCEPT = 49,                  /* $accept  */
+  YYSYMBOL_program = 50,                   /* program  */
+  YYSYMBOL_expressions_list = 51,          /* expressions_list  */
+  YYSYMBOL_expression = 52,                /* expression  */
+  YYSYMBOL_print_expression = 53,          /* print_expression  */
+  YYSYMBOL_display_expression = 54,        /* display_expression  */
+  YYSYMBOL_assignment_expression = 55,     /* assignment_expression  */
+  YYSYMBOL_math_expression = 56,           /* math_expression  */
+  YYSYMBOL_term = 57,                      /* term  */
+  YYSYMBOL_factor = 58,                    /* factor  */
+  YYSYMBOL_power_or_primary = 59,          /* power_or_primary  */
+  YYSYMBOL_primary = 60,                   /* primary  */
+  YYSYMBOL_pair_expression = 61,           /* pair_expression  */
+  YYSYMBOL_vector_expression = 62,         /* vector_expression  */
+  YYSYMBOL_vector_row = 63,                /* vector_row  */
+  YYSYMBOL_matrix_expression = 64,         /* matrix_expression  */
+  YYSYMBOL_expression_list = 65,           /* expression_list  */
+  YYSYMBOL_vector_list = 66,               /* vector_list  */
+  YYSYMBOL_trigonometric_function_call = 67, /* trigonometric_function_call  */
+  YYSYMBOL_logarithmic_function_call = 68, /* logarithmic_function_call  */
+  YYSYMBOL_root_function_call = 69,        /* root_function_call  */
+  YYSYMBOL_matrix_func_param = 70,         /* matrix_func_param  */
+  YYSYMBOL_pair_or_id_param = 71,          /* pair_or_id_param  */
+  YYSYMBOL_id_param = 72,                  /* id_param  */
+  YYSYMBOL_integral_or_bisectionroot = 73, /* integral_or_bisectionroot  */
+  YYSYMBOL_vector_or_id_param = 74,        /* vector_or_id_param  */
+  YYSYMBOL_matrix_function_call = 75,      /* matrix_function_call  */
+  YYSYMBOL_operations_function_call = 76,  /* operations_function_call  */
+  YYSYMBOL_function_call = 77              /* function_call  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  93
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   354
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  49
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  29
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  84
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  234
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   303
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   240,   240,   243,   264,   280,   281,   282,   283,   286,
+     293,   300,   309,   314,   319,   322,   327,   332,   335,   340,
+     343,   348,   351,   356,   361,   366,   371,   377,   378,   379,
+     380,   381,   384,   391,   394,   400,   406,   431,   452,   481,
+     495,   516,   526,   531,   536,   541,   548,   553,   560,   565,
+     572,   577,   583,   584,   591,   598,   603,   610,   611,   618,
+     661,   704,   747,   790,   835,   859,   864,   869,   874,   879,
+     884,   889,   894,   899,   904,   909,   914,   919,   924,   929,
+     936,   937,   938,   939,   940
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "TOKEN_PRINT",
+  "TOKEN_DISPLAY", "TOKEN_LPAREN", "TOKEN_RPAREN", "TOKEN_LBRACKET",
+  "TOKEN_RBRACKET", "TOKEN_LBRACE", "TOKEN_RBRACE", "TOKEN_COMMA",
+  "TOKEN_SEMICOLON", "TOKEN_ASSIGN", "TOKEN_NUMBER", "TOKEN_IDENTIFIER",
+  "TOKEN_ADD", "TOKEN_SUBSTRACT", "TOKEN_MULTIPLY", "TOKEN_DIVIDE",
+  "TOKEN_POW", "TOKEN_LOG", "TOKEN_LN", "TOKEN_SQRT", "TOKEN_ROOT",
+  "TOKEN_SIN", "TOKEN_COS", "TOKEN_TAN", "TOKEN_CTG", "TOKEN_INVERSE",
+  "TOKEN_MATRIXLU", "TOKEN_TRIDIAGONAL", "TOKEN_REALEIGENVALUES",
+  "TOKEN_DETERMINANT", "TOKEN_BISECTIONROOT", "TOKEN_PI", "TOKEN_EULER",
+  "TOKEN_INTEGRAL", "TOKEN_ODEFIRST", "TOKEN_INTERPOLATE", "TOKEN_STRING",
+  "TOKEN_DERIVATIVE", "TOKEN_FINDROOT", "TOKEN_ALLROOTS", "TOKEN_SPLINE",
+  "TOKEN_POINTS", "TOKEN_LOADCSV", "TOKEN_LOADNPY", "TOKEN_SAVENPY",
+  "$accept", "program", "expressions_list", "expression",
+  "print_expression", "display_expression", "assignment_expression",
+  "math_expression", "term", "factor", "power_or_primary", "primary",
+  "pair_expression", "vector_expression", "vector_row",
+  "matrix_expression", "expression_list", "vector_list",
+  "trigonometric_function_call", "logarithmic_function_call",
+  "root_function_call", "matrix_func_param", "pair_or_id_param",
+  "id_param", "integral_or_bisectionroot", "vector_or_id_param",
+  "matrix_function_call", "operations_function_call", "function_call", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-151)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+       0,    86,    94,   212,   212,    44,  -151,    98,   212,   114,
+     134,   142,   150,   159,   163,   169,   175,   196,   213,   215,
+     217,   219,  -151,  -151,  -151,  -151,   225,   227,  -151,   259,
+     261,   271,   301,   303,   312,   314,   323,    97,     0,  -151,
+    -151,  -151,  -151,   315,    -7,  -151,  -151,    93,  -151,  -151,
+    -151,  -151,  -151,  -151,   325,  -151,  -151,  -151,   102,   212,
+    -151,     2,    62,   205,   212,  -151,  -151,   181,   212,  -151,
+     212,   212,   212,   212,   212,   212,   212,   212,     1,     1,
+       1,     1,     1,   212,   212,   212,    79,    79,   212,   212,
+     212,   212,   212,  -151,  -151,  -151,   212,   212,   212,   212,
+     256,    79,   125,    60,  -151,   212,  -151,   212,   220,  -151,
+      68,   317,   177,    90,    99,   187,   104,   106,   108,   112,
+      44,  -151,   127,   129,   331,   332,   333,   189,   191,   251,
+     212,  -151,  -151,   329,   330,    46,   120,    84,   124,   258,
+      -7,    -7,  -151,  -151,  -151,   334,   335,   336,   126,    62,
+    -151,  -151,  -151,  -151,   212,  -151,  -151,   212,  -151,  -151,
+    -151,  -151,   262,  -151,  -151,  -151,  -151,  -151,   212,   212,
+     327,   294,   212,   212,  -151,   212,  -151,  -151,   212,  -151,
+     212,   212,  -151,  -151,  -151,   128,   132,  -151,   296,   140,
+    -151,   338,   298,   305,   144,   146,   165,   307,  -151,  -151,
+     212,  -151,   212,   327,   327,  -151,  -151,  -151,   327,   309,
+     167,    49,   339,   337,   152,  -151,  -151,   212,   212,  -151,
+    -151,  -151,   147,    92,   170,  -151,   212,  -151,   212,  -151,
+     173,   179,  -151,  -151
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     0,    22,    25,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    55,    23,    24,    56,     0,     0,    26,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     2,     4,
+       5,     6,     7,     0,    14,    17,    19,    21,    28,    29,
+      30,    82,    80,    81,     0,    83,    84,    31,     0,     0,
+      25,     0,    37,     0,     0,    41,    39,     0,     0,    18,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     1,     3,     8,     0,     0,     0,     0,
+       0,     0,     0,     0,    27,     0,    33,     0,     0,    35,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    50,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    53,    52,     0,     0,     0,     0,     0,     0,     0,
+      12,    13,    15,    16,    20,     0,     0,     0,     0,    36,
+      34,    40,    38,    11,     0,    47,    48,     0,    42,    43,
+      44,    45,     0,    59,    60,    61,    62,    63,     0,     0,
+       0,     0,     0,     0,    71,     0,    70,    66,     0,    68,
+       0,     0,     9,    10,    32,     0,     0,    51,     0,     0,
+      54,     0,     0,     0,     0,     0,     0,     0,    46,    49,
+       0,    65,     0,     0,     0,    72,    67,    69,     0,     0,
+       0,     0,     0,     0,     0,    75,    76,     0,     0,    64,
+      58,    57,     0,     0,     0,    73,     0,    77,     0,    79,
+       0,     0,    74,    78
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -151,  -151,  -151,   306,  -151,  -151,  -151,    -3,   239,    -6,
+     246,  -151,   -37,   137,   242,  -151,   289,   234,  -151,  -151,
+    -151,   130,   -81,  -150,  -151,  -151,  -151,  -151,  -151
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,    37,    38,    39,    40,    41,    42,    43,    44,    45,
+      46,    47,    48,    49,    66,    50,    63,    67,    51,    52,
+      53,   122,   133,   191,    54,   222,    55,    56,    57
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_uint8 yytable[] =
+{
+      61,    62,    69,     1,     2,     3,   134,     4,   104,     5,
+     120,    98,    99,   105,     6,     7,   121,     8,    96,    97,
+     145,     9,    10,    11,    12,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    31,    32,    33,    34,    35,    36,   132,
+     132,    64,   174,   211,   212,   216,   103,   175,   213,    65,
+     217,    62,    96,    97,   132,   111,   147,   112,   113,   114,
+     115,   116,   117,   118,   119,    64,    96,    97,    96,    97,
+     127,   128,   129,   151,   130,   135,   136,   137,   138,   139,
+     177,    58,   142,   143,   131,   178,   155,    93,   227,    59,
+      96,    97,   148,   228,   149,   156,    96,    97,    96,    97,
+     158,    68,   159,   100,   160,    96,    97,   102,   161,    70,
+      96,    97,    96,    97,    96,    97,   176,   171,    96,    97,
+     179,   146,   184,   163,   198,   164,    96,    97,   199,    71,
+      96,    97,    96,    97,    96,    97,   201,    72,    96,    97,
+     205,   185,   206,   225,   186,    73,    96,    97,   226,     4,
+      96,    97,    96,    97,    74,   188,   189,   220,    75,   192,
+     193,   207,   194,   215,    76,   195,   229,   196,   197,   232,
+      77,    96,    97,    96,    97,   233,    96,    97,   154,    96,
+      97,   109,   110,    96,    97,    96,    97,   209,   157,   210,
+     168,    78,   169,    96,    97,    96,    97,    96,    97,   123,
+     124,   125,   126,   106,   223,   224,   107,     3,    79,     4,
+      80,     5,    81,   230,    82,   231,     6,    60,   150,     8,
+      83,   107,    84,     9,    10,    11,    12,    13,    14,    15,
+      16,    17,    18,    19,    20,    21,    22,    23,    24,    25,
+      26,    27,    28,    29,    30,    31,    32,    33,    34,    35,
+      36,     3,   170,     4,    85,     5,    86,    96,    97,   180,
+       6,    60,   187,   110,    96,    97,    87,     9,    10,    11,
+      12,    13,    14,    15,    16,    17,    18,    19,    20,    21,
+      22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
+      32,    33,    34,    35,    36,   105,    88,   200,    89,   203,
+      96,    97,    96,    97,    96,    97,   204,    90,   208,    91,
+     214,    96,    97,    96,    97,    96,    97,    95,    92,   153,
+     101,    96,    97,    96,    97,   140,   141,   165,   166,   167,
+     172,   173,   190,   219,    94,   181,   144,   182,   183,   202,
+     218,   221,   152,   108,   162
+};
+
+static const yytype_uint8 yycheck[] =
+{
+       3,     4,     8,     3,     4,     5,    87,     7,     6,     9,
+       9,    18,    19,    11,    14,    15,    15,    17,    16,    17,
+     101,    21,    22,    23,    24,    25,    26,    27,    28,    29,
+      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    44,    45,    46,    47,    48,    86,
+      87,     7,     6,   203,   204,     6,    59,    11,   208,    15,
+      11,    64,    16,    17,   101,    68,     6,    70,    71,    72,
+      73,    74,    75,    76,    77,     7,    16,    17,    16,    17,
+      83,    84,    85,    15,     5,    88,    89,    90,    91,    92,
+       6,     5,    98,    99,    15,    11,     6,     0,     6,     5,
+      16,    17,   105,    11,   107,     6,    16,    17,    16,    17,
+       6,    13,     6,    20,     6,    16,    17,    15,     6,     5,
+      16,    17,    16,    17,    16,    17,     6,   130,    16,    17,
+       6,     6,     6,     6,     6,     6,    16,    17,     6,     5,
+      16,    17,    16,    17,    16,    17,     6,     5,    16,    17,
+       6,   154,     6,     6,   157,     5,    16,    17,    11,     7,
+      16,    17,    16,    17,     5,   168,   169,    15,     5,   172,
+     173,     6,   175,     6,     5,   178,     6,   180,   181,     6,
+       5,    16,    17,    16,    17,     6,    16,    17,    11,    16,
+      17,    10,    11,    16,    17,    16,    17,   200,    11,   202,
+      11,     5,    11,    16,    17,    16,    17,    16,    17,    79,
+      80,    81,    82,     8,   217,   218,    11,     5,     5,     7,
+       5,     9,     5,   226,     5,   228,    14,    15,     8,    17,
+       5,    11,     5,    21,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    43,    44,    45,    46,    47,
+      48,     5,    11,     7,     5,     9,     5,    16,    17,    11,
+      14,    15,    10,    11,    16,    17,     5,    21,    22,    23,
+      24,    25,    26,    27,    28,    29,    30,    31,    32,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
+      44,    45,    46,    47,    48,    11,     5,    11,     5,    11,
+      16,    17,    16,    17,    16,    17,    11,     5,    11,     5,
+      11,    16,    17,    16,    17,    16,    17,    12,     5,    12,
+       5,    16,    17,    16,    17,    96,    97,     6,     6,     6,
+      11,    11,    15,     6,    38,    11,   100,    12,    12,    11,
+      11,   214,   110,    64,   120
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     3,     4,     5,     7,     9,    14,    15,    17,    21,
+      22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
+      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
+      42,    43,    44,    45,    46,    47,    48,    50,    51,    52,
+      53,    54,    55,    56,    57,    58,    59,    60,    61,    62,
+      64,    67,    68,    69,    73,    75,    76,    77,     5,     5,
+      15,    56,    56,    65,     7,    15,    63,    66,    13,    58,
+       5,     5,     5,     5,     5,     5,     5,     5,     5,     5,
+       5,     5,     5,     5,     5,     5,     5,     5,     5,     5,
+       5,     5,     5,     0,    52,    12,    16,    17,    18,    19,
+      20,     5,    15,    56,     6,    11,     8,    11,    65,    10,
+      11,    56,    56,    56,    56,    56,    56,    56,    56,    56,
+       9,    15,    70,    70,    70,    70,    70,    56,    56,    56,
+       5,    15,    61,    71,    71,    56,    56,    56,    56,    56,
+      57,    57,    58,    58,    59,    71,     6,     6,    56,    56,
+       8,    15,    63,    12,    11,     6,     6,    11,     6,     6,
+       6,     6,    66,     6,     6,     6,     6,     6,    11,    11,
+      11,    56,    11,    11,     6,    11,     6,     6,    11,     6,
+      11,    11,    12,    12,     6,    56,    56,    10,    56,    56,
+      15,    72,    56,    56,    56,    56,    56,    56,     6,     6,
+      11,     6,    11,    11,    11,     6,     6,     6,    11,    56,
+      56,    72,    72,    72,    11,     6,     6,    11,    11,     6,
+      15,    62,    74,    56,    56,     6,    11,     6,    11,     6,
+      56,    56,     6,     6
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    49,    50,    51,    51,    52,    52,    52,    52,    53,
+      54,    55,    56,    56,    56,    57,    57,    57,    58,    58,
+      59,    59,    60,    60,    60,    60,    60,    60,    60,    60,
+      60,    60,    61,    62,    63,    64,    65,    65,    66,    66,
+      66,    66,    67,    67,    67,    67,    68,    68,    69,    69,
+      70,    70,    71,    71,    72,    73,    73,    74,    74,    75,
+      75,    75,    75,    75,    76,    76,    76,    76,    76,    76,
+      76,    76,    76,    76,    76,    76,    76,    76,    76,    76,
+      77,    77,    77,    77,    77
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     2,     1,     1,     1,     1,     2,     5,
+       5,     4,     3,     3,     1,     3,     3,     1,     2,     1,
+       3,     1,     1,     1,     1,     1,     1,     3,     1,     1,
+       1,     1,     5,     3,     3,     3,     3,     1,     3,     1,
+       3,     1,     4,     4,     4,     4,     6,     4,     4,     6,
+       1,     3,     1,     1,     1,     1,     1,     1,     1,     4,
+       4,     4,     4,     4,     8,     6,     4,     6,     4,     6,
+       4,     4,     6,    10,    12,     8,     8,    10,    12,    10,
+       1,     1,     1,     1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (context, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, context); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, ParseContext* context)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (context);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, ParseContext* context)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, context);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, ParseContext* context)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], context);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, context); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, ParseContext* context)
+{
+  YY_USE (yyvaluep);
+  YY_USE (context);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (ParseContext* context)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, context);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* program: expressions_list  */
+#line 240 "parser.bison"
+                                                                    { context->result = yyvsp[0]; }
+#line 1504 "build/parser.c"
+    break;
+
+  case 3: /* expressions_list: expressions_list expression  */
+#line 243 "parser.bison"
+                                                                    {
+                                                                        ExpressionList* exprList = dynamic_cast<ExpressionList*>(yyvsp[-1]);
+                                                                        if (context->statement_handler)
+                                                                        {
+                                                                            runStatement(context, yyvsp[0]);
+                                                                            yyval = nullptr;
+                                                                        }
+                                                                        else if (exprList)
+                                                                        {
+                                                                            exprList->addExpressionBack(yyvsp[0]);
+                                                                            yyval = exprList;
+                                                                        }
+                                                                        else
+                                                                        {
+                                                                            ExpressionList* newList = new ExpressionList();
+                                                                            newList->addExpressionBack(yyvsp[-1]);
+                                                                            newList->addExpressionBack(yyvsp[0]);
+                                                                            context->pointers.emplace(newList);
+                                                                            yyval = newList;
+                                                                        }
+                                                                    }
+#line 1530 "build/parser.c"
+    break;
+
+  case 4: /* expressions_list: expression  */
+#line 264 "parser.bison"
+                                                                    {
+                                                                        if (context->statement_handler)
+                                                                        {
+                                                                            runStatement(context, yyvsp[0]);
+                                                                            yyval = nullptr;
+                                                                        }
+                                                                        else
+                                                                        {
+                                                                            ExpressionList* newList = new ExpressionList();
+                                                                            newList->addExpressionBack(yyvsp[0]);
+                                                                            context->pointers.emplace(newList);
+                                                                            yyval = newList;
+                                                                        }
+                                                                    }
+#line 1549 "build/parser.c"
+    break;
+
+  case 8: /* expression: math_expression TOKEN_SEMICOLON  */
+#line 283 "parser.bison"
+                                                                    { yyval = yyvsp[-1]; }
+#line 1555 "build/parser.c"
+    break;
+
+  case 9: /* print_expression: TOKEN_PRINT TOKEN_LPAREN TOKEN_IDENTIFIER TOKEN_RPAREN TOKEN_SEMICOLON  */
+#line 286 "parser.bison"
+                                                                                            {
+                                                                                                Expression* e = new Print(context->id);
+                                                                                                context->pointers.emplace(e);
+                                                                                                yyval = e;
+                                                                                            }
+#line 1565 "build/parser.c"
+    break;
+
+  case 10: /* display_expression: TOKEN_DISPLAY TOKEN_LPAREN math_expression TOKEN_RPAREN TOKEN_SEMICOLON  */
+#line 293 "parser.bison"
+                                                                                             {
+                                                                                                Expression* e = new Display(yyvsp[-2]);
+                                                                                                context->pointers.emplace(e);
+                                                                                                yyval = e;
+                                                                                             }
+#line 1575 "build/parser.c"
+    break;
+
+  case 11: /* assignment_expression: TOKEN_IDENTIFIER TOKEN_ASSIGN math_expression TOKEN_SEMICOLON  */
+#line 300 "parser.bison"
+                                                                                      {
+                                                                                        Expression* name = new Name(context->assing_id);
+                                                                                        Expression* e = new Assigment(name, yyvsp[-1]);
+                                                                                        context->pointers.emplace(name);
+                                                                                        context->pointers.emplace(e);
+                                                                                        yyval = e;
+                                                                                      }
+#line 1587 "build/parser.c"
+    break;
+
+  case 12: /* math_expression: math_expression TOKEN_ADD term  */
+#line 309 "parser.bison"
+                                                 {
+                                                   Expression* e = new Addition(yyvsp[-2], yyvsp[0]);
+                                                   context->pointers.emplace(e);
+                                                   yyval = e;
+                                                 }
+#line 1597 "build/parser.c"
+    break;
+
+  case 13: /* math_expression: math_expression TOKEN_SUBSTRACT term  */
+#line 314 "parser.bison"
+                                                       {
+                                                         Expression* e = new Substraction(yyvsp[-2], yyvsp[0]);
+                                                         context->pointers.emplace(e);
+                                                         yyval = e;
+                                                       }
+#line 1607 "build/parser.c"
+    break;
+
+  case 14: /* math_expression: term  */
+#line 319 "parser.bison"
+                       { yyval = yyvsp[0]; }
+#line 1613 "build/parser.c"
+    break;
+
+  case 15: /* term: term TOKEN_MULTIPLY factor  */
+#line 322 "parser.bison"
+                                  {
+                                    Expression* e = new Multiplication(yyvsp[-2], yyvsp[0]);
+                                    context->pointers.emplace(e);
+                                    yyval = e;
+                                  }
+#line 1623 "build/parser.c"
+    break;
+
+  case 16: /* term: term TOKEN_DIVIDE factor  */
+#line 327 "parser.bison"
+                                {
+                                    Expression* e = new Division(yyvsp[-2], yyvsp[0]);
+                                    context->pointers.emplace(e);
+                                    yyval = e;
+                                }
+#line 1633 "build/parser.c"
+    break;
+
+  case 17: /* term: factor  */
+#line 332 "parser.bison"
+              { yyval = yyvsp[0]; }
+#line 1639 "build/parser.c"
+    break;
+
+  case 18: /* factor: TOKEN_SUBSTRACT factor  */
+#line 335 "parser.bison"
+                                {
+                                    Expression* e = new Negation(yyvsp[0]);
+                                    context->pointers.emplace(e);
+                                    yyval = e;
+                                }
+#line 1649 "build/parser.c"
+    break;
+
+  case 19: /* factor: power_or_primary  */
+#line 340 "parser.bison"
+                          { yyval = yyvsp[0]; }
+#line 1655 "build/parser.c"
+    break;
+
+  case 20: /* power_or_primary: primary TOKEN_POW power_or_primary  */
+#line 343 "parser.bison"
+                                                      {
+                                                        Expression* e = new Power(yyvsp[-2], yyvsp[0]);
+                                                        context->pointers.emplace(e);
+                                                        yyval = e;
+                                                      }
+#line 1665 "build/parser.c"
+    break;
+
+  case 21: /* power_or_primary: primary  */
+#line 348 "parser.bison"
+                { yyval = yyvsp[0]; }
+#line 1671 "build/parser.c"
+    break;
+
+  case 22: /* primary: TOKEN_NUMBER  */
+#line 351 "parser.bison"
+                       {
+                            Expression* e = new Number(strtod(yyget_text(context->scanner), NULL));
+                            context->pointers.emplace(e);
+                            yyval = e;
+                        }
+#line 1681 "build/parser.c"
+    break;
+
+  case 23: /* primary: TOKEN_PI  */
+#line 356 "parser.bison"
+                   {
+                        Expression* e = new PI();
+                        context->pointers.emplace(e);
+                        yyval = e;
+                    }
+#line 1691 "build/parser.c"
+    break;
+
+  case 24: /* primary: TOKEN_EULER  */
+#line 361 "parser.bison"
+                      {
+                            Expression* e = new EULER();
+                            context->pointers.emplace(e);
+                            yyval = e;
+                      }
+#line 1701 "build/parser.c"
+    break;
+
+  case 25: /* primary: TOKEN_IDENTIFIER  */
+#line 366 "parser.bison"
+                           {
+                                Expression* e = new Name(context->id);
+                                context->pointers.emplace(e);
+                                yyval = e;
+                            }
+#line 1711 "build/parser.c"
+    break;
+
+  case 26: /* primary: TOKEN_STRING  */
+#line 371 "parser.bison"
+                       {
+                            char* text = yyget_text(context->scanner);
+                            Expression* e = new String(std::string(text + 1, strlen(text) - 2));
+                            context->pointers.emplace(e);
+                            yyval = e;
+                       }
+#line 1722 "build/parser.c"
+    break;
+
+  case 27: /* primary: TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 377 "parser.bison"
+                                                    { yyval = yyvsp[-1]; }
+#line 1728 "build/parser.c"
+    break;
+
+  case 32: /* pair_expression: TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 384 "parser.bison"
+                                                                                        {
+                                                                                            Expression* e = new Pair(yyvsp[-3], yyvsp[-1]);
+                                                                                            context->pointers.emplace(e);
+                                                                                            yyval = e;
+                                                                                        }
+#line 1738 "build/parser.c"
+    break;
+
+  case 33: /* vector_expression: TOKEN_LBRACKET expression_list TOKEN_RBRACKET  */
+#line 391 "parser.bison"
+                                                                                        { yyval = vectorFromList(context, yyvsp[-1]); }
+#line 1744 "build/parser.c"
+    break;
+
+  case 34: /* vector_row: TOKEN_LBRACKET expression_list TOKEN_RBRACKET  */
+#line 394 "parser.bison"
+                                                                                        {
+                                                                                            NumberList* numbers = dynamic_cast<NumberList*>(yyvsp[-1]);
+                                                                                            yyval = (numbers != nullptr) ? numbers : vectorFromList(context, yyvsp[-1]);
+                                                                                        }
+#line 1753 "build/parser.c"
+    break;
+
+  case 35: /* matrix_expression: TOKEN_LBRACE vector_list TOKEN_RBRACE  */
+#line 400 "parser.bison"
+                                                                                        {
+                                                                                            NumberList* numbers = dynamic_cast<NumberList*>(yyvsp[-1]);
+                                                                                            yyval = (numbers != nullptr) ? denseMatrix(context, numbers) : matrixFromList(context, yyvsp[-1]);
+                                                                                        }
+#line 1762 "build/parser.c"
+    break;
+
+  case 36: /* expression_list: expression_list TOKEN_COMMA math_expression  */
+#line 406 "parser.bison"
+                                                                                        {
+                                                                                            double value = 0.0;
+                                                                                            NumberList* numbers = dynamic_cast<NumberList*>(yyvsp[-2]);
+                                                                                            ExpressionList* list = nullptr;
+                                                                                            if (numbers != nullptr && numericConstant(yyvsp[0], value))
+                                                                                            {
+                                                                                                numbers->addNumber(value);
+                                                                                                releaseConstant(context, yyvsp[0]);
+                                                                                                yyval = numbers;
+                                                                                            }
+                                                                                            else if ((list = (numbers != nullptr) ? expandNumbers(context, numbers) : dynamic_cast<ExpressionList*>(yyvsp[-2])))
+                                                                                            {
+                                                                                                list->addExpressionBack(yyvsp[0]);
+                                                                                                yyval = list;
+                                                                                            }
+                                                                                            else
+                                                                                            {
+                                                                                                ExpressionList* newList = new ExpressionList();
+                                                                                                newList->addExpressionBack(yyvsp[-2]);
+                                                                                                newList->addExpressionBack(yyvsp[0]);
+                                                                                                Expression* e = newList;
+                                                                                                context->pointers.emplace(e);
+                                                                                                yyval = e;
+                                                                                            }
+                                                                                        }
+#line 1792 "build/parser.c"
+    break;
+
+  case 37: /* expression_list: math_expression  */
+#line 431 "parser.bison"
+                                                                                        {
+                                                                                            double value = 0.0;
+                                                                                            if (numericConstant(yyvsp[0], value))
+                                                                                            {
+                                                                                                NumberList* numbers = new NumberList();
+                                                                                                numbers->addNumber(value);
+                                                                                                releaseConstant(context, yyvsp[0]);
+                                                                                                context->pointers.emplace(numbers);
+                                                                                                yyval = numbers;
+                                                                                            }
+                                                                                            else
+                                                                                            {
+                                                                                                ExpressionList* newList = new ExpressionList();
+                                                                                                newList->addExpressionBack(yyvsp[0]);
+                                                                                                Expression* e = newList;
+                                                                                                context->pointers.emplace(e);
+                                                                                                yyval = e;
+                                                                                            }
+                                                                                        }
+#line 1816 "build/parser.c"
+    break;
+
+  case 38: /* vector_list: vector_list TOKEN_COMMA vector_row  */
+#line 452 "parser.bison"
+                                                                                        {
+                                                                                            NumberList* numbers = dynamic_cast<NumberList*>(yyvsp[-2]);
+                                                                                            NumberList* row = dynamic_cast<NumberList*>(yyvsp[0]);
+                                                                                            if (numbers != nullptr && row != nullptr && numbers->addRows(*row))
+                                                                                            {
+                                                                                                context->pointers.erase(row);
+                                                                                                delete row;
+                                                                                                yyval = numbers;
+                                                                                            }
+                                                                                            else
+                                                                                            {
+                                                                                                ExpressionList* list = (numbers != nullptr) ? expandRows(context, numbers) : dynamic_cast<ExpressionList*>(yyvsp[-2]);
+                                                                                                Expression* element = (row != nullptr) ? vectorFromList(context, row) : yyvsp[0];
+                                                                                                if (list)
+                                                                                                {
+                                                                                                    list->addExpressionBack(element);
+                                                                                                    yyval = list;
+                                                                                                }
+                                                                                                else
+                                                                                                {
+                                                                                                    ExpressionList* newList = new ExpressionList();
+                                                                                                    newList->addExpressionBack(yyvsp[-2]);
+                                                                                                    newList->addExpressionBack(element);
+                                                                                                    Expression* e = newList;
+                                                                                                    context->pointers.emplace(e);
+                                                                                                    yyval = e;
+                                                                                                }
+                                                                                            }
+                                                                                        }
+#line 1850 "build/parser.c"
+    break;
+
+  case 39: /* vector_list: vector_row  */
+#line 481 "parser.bison"
+                                                                                        {
+                                                                                            if (NumberList* numbers = dynamic_cast<NumberList*>(yyvsp[0]))
+                                                                                            {
+                                                                                                yyval = numbers;
+                                                                                            }
+                                                                                            else
+                                                                                            {
+                                                                                                ExpressionList* newList = new ExpressionList();
+                                                                                                newList->addExpressionBack(yyvsp[0]);
+                                                                                                Expression* e = newList;
+                                                                                                context->pointers.emplace(e);
+                                                                                                yyval = e;
+                                                                                            }
+                                                                                        }
+#line 1869 "build/parser.c"
+    break;
+
+  case 40: /* vector_list: vector_list TOKEN_COMMA TOKEN_IDENTIFIER  */
+#line 495 "parser.bison"
+                                                                                        {
+                                                                                            NumberList* numbers = dynamic_cast<NumberList*>(yyvsp[-2]);
+                                                                                            ExpressionList* list = (numbers != nullptr) ? expandRows(context, numbers) : dynamic_cast<ExpressionList*>(yyvsp[-2]);
+                                                                                            if (list)
+                                                                                            {
+                                                                                                Expression* name = new Name(context->id);
+                                                                                                list->addExpressionBack(name);
+                                                                                                context->pointers.emplace(name);
+                                                                                                yyval = list;
+                                                                                            }
+                                                                                            else
+                                                                                            {
+                                                                                                ExpressionList* newList = new ExpressionList();
+                                                                                                newList->addExpressionBack(yyvsp[-2]);
+                                                                                                Expression* name = new Name(context->id);
+                                                                                                newList->addExpressionBack(name);
+                                                                                                context->pointers.emplace(name);
+                                                                                                context->pointers.emplace(newList);
+                                                                                                yyval = newList;
+                                                                                            }
+                                                                                        }
+#line 1895 "build/parser.c"
+    break;
+
+  case 41: /* vector_list: TOKEN_IDENTIFIER  */
+#line 516 "parser.bison"
+                                                                                        {
+                                                                                            ExpressionList* newList = new ExpressionList();
+                                                                                            Expression* name = new Name(context->id);
+                                                                                            newList->addExpressionBack(name);
+                                                                                            context->pointers.emplace(name);
+                                                                                            context->pointers.emplace(newList);
+                                                                                            yyval = newList;
+                                                                                        }
+#line 1908 "build/parser.c"
+    break;
+
+  case 42: /* trigonometric_function_call: TOKEN_SIN TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 526 "parser.bison"
+                                                                                 {
+                                                                                    Expression* e = new Sine(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                                }
+#line 1918 "build/parser.c"
+    break;
+
+  case 43: /* trigonometric_function_call: TOKEN_COS TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 531 "parser.bison"
+                                                                                 {
+                                                                                    Expression* e = new Cosine(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                                 }
+#line 1928 "build/parser.c"
+    break;
+
+  case 44: /* trigonometric_function_call: TOKEN_TAN TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 536 "parser.bison"
+                                                                                 {
+                                                                                    Expression* e = new Tangent(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                                 }
+#line 1938 "build/parser.c"
+    break;
+
+  case 45: /* trigonometric_function_call: TOKEN_CTG TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 541 "parser.bison"
+                                                                                 {
+                                                                                    Expression* e = new Cotangent(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                                 }
+#line 1948 "build/parser.c"
+    break;
+
+  case 46: /* logarithmic_function_call: TOKEN_LOG TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 548 "parser.bison"
+                                                                                                            {
+                                                                                                                Expression* e = new Logarithm(yyvsp[-3], yyvsp[-1]);
+                                                                                                                context->pointers.emplace(e);
+                                                                                                                yyval = e;
+                                                                                                            }
+#line 1958 "build/parser.c"
+    break;
+
+  case 47: /* logarithmic_function_call: TOKEN_LN TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 553 "parser.bison"
+                                                                               {
+                                                                                    Expression* e = new NaturalLogarithm(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                               }
+#line 1968 "build/parser.c"
+    break;
+
+  case 48: /* root_function_call: TOKEN_SQRT TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 560 "parser.bison"
+                                                                          {
+                                                                                Expression* e = new SquareRoot(yyvsp[-1]);
+                                                                                context->pointers.emplace(e);
+                                                                                yyval = e;
+                                                                          }
+#line 1978 "build/parser.c"
+    break;
+
+  case 49: /* root_function_call: TOKEN_ROOT TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 565 "parser.bison"
+                                                                                                      {
+                                                                                                            Expression* e = new Root(yyvsp[-3], yyvsp[-1]);
+                                                                                                            context->pointers.emplace(e);
+                                                                                                            yyval = e;
+                                                                                                      }
+#line 1988 "build/parser.c"
+    break;
+
+  case 50: /* matrix_func_param: TOKEN_IDENTIFIER  */
+#line 572 "parser.bison"
+                                     {
+                                        Expression* e = new Name(context->id);
+                                        context->pointers.emplace(e);
+                                        yyval = e;
+                                    }
+#line 1998 "build/parser.c"
+    break;
+
+  case 51: /* matrix_func_param: TOKEN_LBRACE vector_list TOKEN_RBRACE  */
+#line 577 "parser.bison"
+                                                          {
+                                                                NumberList* numbers = dynamic_cast<NumberList*>(yyvsp[-1]);
+                                                                yyval = (numbers != nullptr) ? denseMatrix(context, numbers) : yyvsp[-1];
+                                                          }
+#line 2007 "build/parser.c"
+    break;
+
+  case 52: /* pair_or_id_param: pair_expression  */
+#line 583 "parser.bison"
+                                   { yyval = yyvsp[0]; }
+#line 2013 "build/parser.c"
+    break;
+
+  case 53: /* pair_or_id_param: TOKEN_IDENTIFIER  */
+#line 584 "parser.bison"
+                                    {
+                                        Expression* e = new Name(context->id);
+                                        context->pointers.emplace(e);
+                                        yyval = e;
+                                    }
+#line 2023 "build/parser.c"
+    break;
+
+  case 54: /* id_param: TOKEN_IDENTIFIER  */
+#line 591 "parser.bison"
+                             {
+                                Expression* e = new Name(context->id);
+                                context->pointers.emplace(e);
+                                yyval = e;
+                             }
+#line 2033 "build/parser.c"
+    break;
+
+  case 55: /* integral_or_bisectionroot: TOKEN_BISECTIONROOT  */
+#line 598 "parser.bison"
+                                                {
+                                                    Expression* e = new Name("BISECTIONROOT");
+                                                    context->pointers.emplace(e);
+                                                    yyval = e;
+                                                }
+#line 2043 "build/parser.c"
+    break;
+
+  case 56: /* integral_or_bisectionroot: TOKEN_INTEGRAL  */
+#line 603 "parser.bison"
+                                           {
+                                                Expression* e = new Name("INTEGRAL");
+                                                context->pointers.emplace(e);
+                                                yyval = e;
+                                           }
+#line 2053 "build/parser.c"
+    break;
+
+  case 57: /* vector_or_id_param: vector_expression  */
+#line 610 "parser.bison"
+                                       { yyval = yyvsp[0]; }
+#line 2059 "build/parser.c"
+    break;
+
+  case 58: /* vector_or_id_param: TOKEN_IDENTIFIER  */
+#line 611 "parser.bison"
+                                      {
+                                        Expression* e = new Name(context->id);
+                                        context->pointers.emplace(e);
+                                        yyval = e;
+                                      }
+#line 2069 "build/parser.c"
+    break;
+
+  case 59: /* matrix_function_call: TOKEN_INVERSE TOKEN_LPAREN matrix_func_param TOKEN_RPAREN  */
+#line 618 "parser.bison"
+                                                                                 {
+                                                                                    Name* name = dynamic_cast<Name*>(yyvsp[-1]);
+                                                                                    if (name != nullptr || dynamic_cast<Matrix*>(yyvsp[-1]) != nullptr)
+                                                                                    {
+                                                                                        Expression* e = new InverseMatrix(yyvsp[-1]);
+                                                                                        context->pointers.emplace(e);
+                                                                                        yyval = e;
+                                                                                    }
+                                                                                    else
+                                                                                    {
+                                                                                        std::vector<Expression*> matrix{};
+                                                                                        ExpressionList* list = dynamic_cast<ExpressionList*>(yyvsp[-1]);
+                                                                                        if (list)
+                                                                                        {
+                                                                                            for (auto expr : list->getVectorExpression())
+                                                                                            {
+                                                                                                Vector* vec = dynamic_cast<Vector*>(expr);
+                                                                                                if (vec)
+                                                                                                {
+                                                                                                    matrix.push_back(vec);
+                                                                                                }
+                                                                                                else
+                                                                                                {
+                                                                                                    Name* name = dynamic_cast<Name*>(expr);
+                                                                                                    if (name)
+                                                                                                    {
+                                                                                                        matrix.push_back(name);
+                                                                                                    }
+                                                                                                }
+                                                                                            }
+                                                                                        }
+                                                                                        if (context->pointers.find(yyvsp[-1]) != context->pointers.end())
+                                                                                        {
+                                                                                            context->pointers.erase(yyvsp[-1]);
+                                                                                        }
+                                                                                        delete yyvsp[-1];
+                                                                                        Expression* e = new Matrix(matrix);
+                                                                                        context->pointers.emplace(e);
+                                                                                        Expression* e2 = new InverseMatrix(e);
+                                                                                        context->pointers.emplace(e2);
+                                                                                        yyval = e2;
+                                                                                    }
+                                                                                 }
+#line 2117 "build/parser.c"
+    break;
+
+  case 60: /* matrix_function_call: TOKEN_MATRIXLU TOKEN_LPAREN matrix_func_param TOKEN_RPAREN  */
+#line 661 "parser.bison"
+                                                                                  {
+                                                                                    Name* name = dynamic_cast<Name*>(yyvsp[-1]);
+                                                                                    if (name != nullptr || dynamic_cast<Matrix*>(yyvsp[-1]) != nullptr)
+                                                                                    {
+                                                                                        Expression* e = new MatrixLU(yyvsp[-1]);
+                                                                                        context->pointers.emplace(e);
+                                                                                        yyval = e;
+                                                                                    }
+                                                                                    else
+                                                                                    {
+                                                                                        std::vector<Expression*> matrix{};
+                                                                                        ExpressionList* list = dynamic_cast<ExpressionList*>(yyvsp[-1]);
+                                                                                        if (list)
+                                                                                        {
+                                                                                            for (auto expr : list->getVectorExpression())
+                                                                                            {
+                                                                                                Vector* vec = dynamic_cast<Vector*>(expr);
+                                                                                                if (vec)
+                                                                                                {
+                                                                                                    matrix.push_back(vec);
+                                                                                                }
+                                                                                                else
+                                                                                                {
+                                                                                                    Name* name = dynamic_cast<Name*>(expr);
+                                                                                                    if (name)
+                                                                                                    {
+                                                                                                        matrix.push_back(name);
+                                                                                                    }
+                                                                                                }
+                                                                                            }
+                                                                                        }
+                                                                                        if (context->pointers.find(yyvsp[-1]) != context->pointers.end())
+                                                                                        {
+                                                                                            context->pointers.erase(yyvsp[-1]);
+                                                                                        }
+                                                                                        delete yyvsp[-1];
+                                                                                        Expression* e = new Matrix(matrix);
+                                                                                        context->pointers.emplace(e);
+                                                                                        Expression* e2 = new MatrixLU(e);
+                                                                                        context->pointers.emplace(e2);
+                                                                                        yyval = e2;
+                                                                                    }
+                                                                                  }
+#line 2165 "build/parser.c"
+    break;
+
+  case 61: /* matrix_function_call: TOKEN_TRIDIAGONAL TOKEN_LPAREN matrix_func_param TOKEN_RPAREN  */
+#line 704 "parser.bison"
+                                                                                     {
+                                                                                        Name* name = dynamic_cast<Name*>(yyvsp[-1]);
+                                                                                        if (name != nullptr || dynamic_cast<Matrix*>(yyvsp[-1]) != nullptr)
+                                                                                        {
+                                                                                            Expression* e = new TridiagonalMatrix(yyvsp[-1]);
+                                                                                            context->pointers.emplace(e);
+                                                                                            yyval = e;
+                                                                                        }
+                                                                                        else
+                                                                                        {
+                                                                                            std::vector<Expression*> matrix{};
+                                                                                            ExpressionList* list = dynamic_cast<ExpressionList*>(yyvsp[-1]);
+                                                                                            if (list)
+                                                                                            {
+                                                                                                for (auto expr : list->getVectorExpression())
+                                                                                                {
+                                                                                                    Vector* vec = dynamic_cast<Vector*>(expr);
+                                                                                                    if (vec)
+                                                                                                    {
+                                                                                                        matrix.push_back(vec);
+                                                                                                    }
+                                                                                                    else
+                                                                                                    {
+                                                                                                        Name* name = dynamic_cast<Name*>(expr);
+                                                                                                        if (name)
+                                                                                                        {
+                                                                                                            matrix.push_back(name);
+                                                                                                        }
+                                                                                                    }
+                                                                                                }
+                                                                                            }
+                                                                                            if (context->pointers.find(yyvsp[-1]) != context->pointers.end())
+                                                                                            {
+                                                                                                context->pointers.erase(yyvsp[-1]);
+                                                                                            }
+                                                                                            delete yyvsp[-1];
+                                                                                            Expression* e = new Matrix(matrix);
+                                                                                            context->pointers.emplace(e);
+                                                                                            Expression* e2 = new TridiagonalMatrix(e);
+                                                                                            context->pointers.emplace(e2);
+                                                                                            yyval = e2;
+                                                                                        }
+                                                                                     }
+#line 2213 "build/parser.c"
+    break;
+
+  case 62: /* matrix_function_call: TOKEN_REALEIGENVALUES TOKEN_LPAREN matrix_func_param TOKEN_RPAREN  */
+#line 747 "parser.bison"
+                                                                                         {
+                                                                                            Name* name = dynamic_cast<Name*>(yyvsp[-1]);
+                                                                                            if (name != nullptr || dynamic_cast<Matrix*>(yyvsp[-1]) != nullptr)
+                                                                                            {
+                                                                                                Expression* e = new RealEigenvalues(yyvsp[-1]);
+                                                                                                context->pointers.emplace(e);
+                                                                                                yyval = e;
+                                                                                            }
+                                                                                            else
+                                                                                            {
+                                                                                                std::vector<Expression*> matrix{};
+                                                                                                ExpressionList* list = dynamic_cast<ExpressionList*>(yyvsp[-1]);
+                                                                                                if (list)
+                                                                                                {
+                                                                                                    for (auto expr : list->getVectorExpression())
+                                                                                                    {
+                                                                                                        Vector* vec = dynamic_cast<Vector*>(expr);
+                                                                                                        if (vec)
+                                                                                                        {
+                                                                                                            matrix.push_back(vec);
+                                                                                                        }
+                                                                                                        else
+                                                                                                        {
+                                                                                                            Name* name = dynamic_cast<Name*>(expr);
+                                                                                                            if (name)
+                                                                                                            {
+                                                                                                                matrix.push_back(name);
+                                                                                                            }
+                                                                                                        }
+                                                                                                    }
+                                                                                                }
+                                                                                                if (context->pointers.find(yyvsp[-1]) != context->pointers.end())
+                                                                                                {
+                                                                                                    context->pointers.erase(yyvsp[-1]);
+                                                                                                }
+                                                                                                delete yyvsp[-1];
+                                                                                                Expression* e = new Matrix(matrix);
+                                                                                                context->pointers.emplace(e);
+                                                                                                Expression* e2 = new RealEigenvalues(e);
+                                                                                                context->pointers.emplace(e2);
+                                                                                                yyval = e2;
+                                                                                            }
+                                                                                         }
+#line 2261 "build/parser.c"
+    break;
+
+  case 63: /* matrix_function_call: TOKEN_DETERMINANT TOKEN_LPAREN matrix_func_param TOKEN_RPAREN  */
+#line 790 "parser.bison"
+                                                                                     {
+                                                                                        Name* name = dynamic_cast<Name*>(yyvsp[-1]);
+                                                                                        if (name != nullptr || dynamic_cast<Matrix*>(yyvsp[-1]) != nullptr)
+                                                                                        {
+                                                                                            Expression* e = new Determinant(yyvsp[-1]);
+                                                                                            context->pointers.emplace(e);
+                                                                                            yyval = e;
+                                                                                        }
+                                                                                        else
+                                                                                        {
+                                                                                            std::vector<Expression*> matrix{};
+                                                                                            ExpressionList* list = dynamic_cast<ExpressionList*>(yyvsp[-1]);
+                                                                                            if (list)
+                                                                                            {
+                                                                                                for (auto expr : list->getVectorExpression())
+                                                                                                {
+                                                                                                    Vector* vec = dynamic_cast<Vector*>(expr);
+                                                                                                    if (vec)
+                                                                                                    {
+                                                                                                        matrix.push_back(vec);
+                                                                                                    }
+                                                                                                    else
+                                                                                                    {
+                                                                                                        Name* name = dynamic_cast<Name*>(expr);
+                                                                                                        if (name)
+                                                                                                        {
+                                                                                                            matrix.push_back(name);
+                                                                                                        }
+                                                                                                    }
+                                                                                                }
+                                                                                            }
+                                                                                            if (context->pointers.find(yyvsp[-1]) != context->pointers.end())
+                                                                                            {
+                                                                                                context->pointers.erase(yyvsp[-1]);
+                                                                                            }
+                                                                                            delete yyvsp[-1];
+                                                                                            Expression* e = new Matrix(matrix);
+                                                                                            context->pointers.emplace(e);
+                                                                                            Expression* e2 = new Determinant(e);
+                                                                                            context->pointers.emplace(e2);
+                                                                                            yyval = e2;
+                                                                                        }
+                                                                                     }
+#line 2309 "build/parser.c"
+    break;
+
+  case 64: /* operations_function_call: integral_or_bisectionroot TOKEN_LPAREN pair_or_id_param TOKEN_COMMA math_expression TOKEN_COMMA id_param TOKEN_RPAREN  */
+#line 835 "parser.bison"
+                                                                                                                                                 {
+                                                                                                                                                    if (dynamic_cast<Name*>(yyvsp[-7])->getName() == "BISECTIONROOT")
+                                                                                                                                                    {
+                                                                                                                                                        if (context->pointers.find(yyvsp[-7]) != context->pointers.end())
+                                                                                                                                                        {
+                                                                                                                                                            context->pointers.erase(yyvsp[-7]);
+                                                                                                                                                        }
+                                                                                                                                                        delete yyvsp[-7];
+                                                                                                                                                        Expression* e = new FindRootBisection(yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                                        context->pointers.emplace(e);
+                                                                                                                                                        yyval = e;
+                                                                                                                                                    }
+                                                                                                                                                    else
+                                                                                                                                                    {
+                                                                                                                                                        if (context->pointers.find(yyvsp[-7]) != context->pointers.end())
+                                                                                                                                                        {
+                                                                                                                                                            context->pointers.erase(yyvsp[-7]);
+                                                                                                                                                        }
+                                                                                                                                                        delete yyvsp[-7];
+                                                                                                                                                        Expression* e = new Integral(yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                                        context->pointers.emplace(e);
+                                                                                                                                                        yyval = e;
+                                                                                                                                                    }
+                                                                                                                                                 }
+#line 2338 "build/parser.c"
+    break;
+
+  case 65: /* operations_function_call: TOKEN_INTERPOLATE TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 859 "parser.bison"
+                                                                                                                   {   
+                                                                                                                            Expression* e = new Interpolate(yyvsp[-3], yyvsp[-1]);
+                                                                                                                            context->pointers.emplace(e);
+                                                                                                                            yyval = e;
+                                                                                                                      }
+#line 2348 "build/parser.c"
+    break;
+
+  case 66: /* operations_function_call: TOKEN_LOADCSV TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 864 "parser.bison"
+                                                                                   {
+                                                                                    Expression* e = new LoadCsv(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                              }
+#line 2358 "build/parser.c"
+    break;
+
+  case 67: /* operations_function_call: TOKEN_LOADCSV TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 869 "parser.bison"
+                                                                                                               {
+                                                                                                            Expression* e = new LoadCsv(yyvsp[-3], yyvsp[-1]);
+                                                                                                            context->pointers.emplace(e);
+                                                                                                            yyval = e;
+                                                                                                      }
+#line 2368 "build/parser.c"
+    break;
+
+  case 68: /* operations_function_call: TOKEN_LOADNPY TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 874 "parser.bison"
+                                                                                   {
+                                                                                    Expression* e = new LoadNpy(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                              }
+#line 2378 "build/parser.c"
+    break;
+
+  case 69: /* operations_function_call: TOKEN_SAVENPY TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 879 "parser.bison"
+                                                                                                               {
+                                                                                                            Expression* e = new SaveNpy(yyvsp[-3], yyvsp[-1]);
+                                                                                                            context->pointers.emplace(e);
+                                                                                                            yyval = e;
+                                                                                                      }
+#line 2388 "build/parser.c"
+    break;
+
+  case 70: /* operations_function_call: TOKEN_POINTS TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 884 "parser.bison"
+                                                                                  {
+                                                                                    Expression* e = new CreatePoints(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                              }
+#line 2398 "build/parser.c"
+    break;
+
+  case 71: /* operations_function_call: TOKEN_SPLINE TOKEN_LPAREN math_expression TOKEN_RPAREN  */
+#line 889 "parser.bison"
+                                                                                  {
+                                                                                    Expression* e = new CreateSpline(yyvsp[-1]);
+                                                                                    context->pointers.emplace(e);
+                                                                                    yyval = e;
+                                                                              }
+#line 2408 "build/parser.c"
+    break;
+
+  case 72: /* operations_function_call: TOKEN_SPLINE TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 894 "parser.bison"
+                                                                                                              {
+                                                                                                            Expression* e = new CreateSpline(yyvsp[-3], yyvsp[-1]);
+                                                                                                            context->pointers.emplace(e);
+                                                                                                            yyval = e;
+                                                                                                      }
+#line 2418 "build/parser.c"
+    break;
+
+  case 73: /* operations_function_call: TOKEN_ODEFIRST TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_COMMA math_expression TOKEN_COMMA vector_or_id_param TOKEN_RPAREN  */
+#line 899 "parser.bison"
+                                                                                                                                                                           {
+                                                                                                                                                                        Expression* e = new ODEFirstOrderInitialValues(yyvsp[-7], yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                                                        context->pointers.emplace(e);
+                                                                                                                                                                        yyval = e;
+                                                                                                                                                                  }
+#line 2428 "build/parser.c"
+    break;
+
+  case 74: /* operations_function_call: TOKEN_ODEFIRST TOKEN_LPAREN math_expression TOKEN_COMMA math_expression TOKEN_COMMA math_expression TOKEN_COMMA vector_or_id_param TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 904 "parser.bison"
+                                                                                                                                                                                                       {
+                                                                                                                                                                        Expression* e = new ODEFirstOrderInitialValues(yyvsp[-9], yyvsp[-7], yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                                                        context->pointers.emplace(e);
+                                                                                                                                                                        yyval = e;
+                                                                                                                                                                  }
+#line 2438 "build/parser.c"
+    break;
+
+  case 75: /* operations_function_call: TOKEN_DERIVATIVE TOKEN_LPAREN math_expression TOKEN_COMMA id_param TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 909 "parser.bison"
+                                                                                                                                       {
+                                                                                                                                    Expression* e = new Derivative(yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                    context->pointers.emplace(e);
+                                                                                                                                    yyval = e;
+                                                                                                                              }
+#line 2448 "build/parser.c"
+    break;
+
+  case 76: /* operations_function_call: TOKEN_FINDROOT TOKEN_LPAREN pair_or_id_param TOKEN_COMMA math_expression TOKEN_COMMA id_param TOKEN_RPAREN  */
+#line 914 "parser.bison"
+                                                                                                                                      {
+                                                                                                                                    Expression* e = new FindRoot(yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                    context->pointers.emplace(e);
+                                                                                                                                    yyval = e;
+                                                                                                                              }
+#line 2458 "build/parser.c"
+    break;
+
+  case 77: /* operations_function_call: TOKEN_FINDROOT TOKEN_LPAREN pair_or_id_param TOKEN_COMMA math_expression TOKEN_COMMA id_param TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 919 "parser.bison"
+                                                                                                                                                                  {
+                                                                                                                                                            Expression* e = new FindRoot(yyvsp[-7], yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                                            context->pointers.emplace(e);
+                                                                                                                                                            yyval = e;
+                                                                                                                                                      }
+#line 2468 "build/parser.c"
+    break;
+
+  case 78: /* operations_function_call: TOKEN_FINDROOT TOKEN_LPAREN pair_or_id_param TOKEN_COMMA math_expression TOKEN_COMMA id_param TOKEN_COMMA math_expression TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 924 "parser.bison"
+                                                                                                                                                                                              {
+                                                                                                                                                                                    Expression* e = new FindRoot(yyvsp[-9], yyvsp[-7], yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                                                                    context->pointers.emplace(e);
+                                                                                                                                                                                    yyval = e;
+                                                                                                                                                                              }
+#line 2478 "build/parser.c"
+    break;
+
+  case 79: /* operations_function_call: TOKEN_ALLROOTS TOKEN_LPAREN pair_or_id_param TOKEN_COMMA math_expression TOKEN_COMMA id_param TOKEN_COMMA math_expression TOKEN_RPAREN  */
+#line 929 "parser.bison"
+                                                                                                                                                                  {
+                                                                                                                                                            Expression* e = new AllRoots(yyvsp[-7], yyvsp[-5], yyvsp[-3], yyvsp[-1]);
+                                                                                                                                                            context->pointers.emplace(e);
+                                                                                                                                                            yyval = e;
+                                                                                                                                                      }
+#line 2488 "build/parser.c"
+    break;
+
+
+#line 2492 "build/parser.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (context, YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, context);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, context);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (context, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, context);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, context);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 943 "parser.bison"
+
+
+int yyerror(ParseContext* context, const char* s)
+{
+    // The scanner already described an unknown token
+    if (context->error.empty())
+    {
+        context->error = std::string("Syntax error: ") + s;
+    }
+    return 1;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+
 #include "utils.hpp"
 
 class Expression
@@ -7,6 +9,8 @@ class Expression
 public:
     virtual Expression* eval(Environment&) const = 0;
     virtual std::string toString() const noexcept = 0;
+    // Appends the same text as toString(), values override it to render without temporaries
+    virtual void print(std::string& out) const;
     virtual void destroy() noexcept = 0;
     virtual ~Expression();
 };
@@ -28,6 +32,7 @@ public:
     Invalid(const std::string& msg = "");
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
+    const std::string& getMessage() const noexcept;
     void destroy() noexcept override;
 };
 
@@ -39,6 +44,7 @@ class Impossible : public Expression
     Impossible(std::string msg = "");
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
+    const std::string& getMessage() const noexcept;
     void destroy() noexcept override;
 };
 
@@ -83,6 +89,7 @@ public:
     Number(double _number);
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
+    void print(std::string& out) const override;
     double getNumber() const;
 };
 
@@ -113,6 +120,52 @@ public:
     std::string getName() const noexcept;
 };
 
+// A variable whose value refers to names that were not bound when it was assigned. The evaluated
+// value is cached until bindName drops it because one of those names, or a variable that refers
+// to them, is assigned again. Dropping it bumps the version, so an evaluation that started before
+// is not cached. Bindings only change while no
+// statement is running, so evaluating one from several threads at a time is safe.
+class Binding : public Expression
+{
+private:
+    Expression* value;
+    std::vector<std::string> dependencies;
+    bool recursive;
+    uint64_t version;
+    mutable std::mutex mutex;
+    mutable Expression* cached;
+public:
+    Binding(Expression* _value, std::vector<std::string> _dependencies, bool _recursive);
+    // A copy of the cached value, evaluating the assigned value first when the cache is empty
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    void print(std::string& out) const override;
+    void destroy() noexcept override;
+    Expression* getValue() const noexcept;
+    const std::vector<std::string>& getDependencies() const noexcept;
+    // True when the value refers to the variable it is assigned to, checked once by bindName
+    bool isRecursive() const noexcept;
+    uint64_t getVersion() const noexcept;
+    void invalidate() noexcept;
+};
+
+// Binds value to name, replacing the old value, and drops the cached values of the variables that
+// refer to name directly or through other variables
+void bindName(Environment& env, const std::string& name, Expression* value);
+// The value assigned to name, without its Binding, or nullptr
+Expression* lookupName(const Environment& env, const std::string& name);
+
+class String : public Value
+{
+private:
+    std::string text;
+public:
+    String(std::string_view _text);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    std::string getText() const noexcept;
+};
+
 class Negation : public UnaryExpression
 {
 public:
@@ -234,8 +287,9 @@ public:
     Pair(Expression* _first, Expression* _second);
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
-    Expression* getFirst();
-    Expression* getSecond();
+    void print(std::string& out) const override;
+    Expression* getFirst() const;
+    Expression* getSecond() const;
     void destroy() noexcept override;
 };
 
@@ -263,8 +317,9 @@ public:
     Vector(std::vector<Expression*>& _vectorExpression);
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
+    void print(std::string& out) const override;
     std::vector<Expression*> getVectorExpression() const;
-    size_t size()
+    size_t size() const
     {
         return vectorExpression.size();
     }
@@ -274,15 +329,36 @@ public:
 class Matrix : public Value
 {
 protected:
-    std::vector<Expression*> matrixExpression;
+    // Rows of a dense matrix are only built when a caller asks for them, once even when threads
+    // that share the matrix through a binding or the memo cache ask at the same time
+    mutable std::vector<Expression*> matrixExpression;
+    mutable std::once_flag expanded;
+    std::shared_ptr<const double> dense;
+    size_t rows;
+    size_t columns;
 public:
     Matrix(std::vector<Expression*>& _matrixExpression);
+    Matrix(std::shared_ptr<const double> _dense, size_t _rows, size_t _columns);
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
+    void print(std::string& out) const override;
     std::vector<Expression*> getMatrixExpression() const;
-    size_t size()
+    bool isDense() const noexcept
     {
-        return matrixExpression.size();
+        return dense != nullptr;
+    }
+    // Row-major storage of a dense matrix, nullptr otherwise
+    const double* getData() const noexcept
+    {
+        return dense.get();
+    }
+    size_t getColumns() const noexcept
+    {
+        return columns;
+    }
+    size_t size() const
+    {
+        return isDense() ? rows : matrixExpression.size();
     }
     void destroy() noexcept override;
 };
@@ -294,6 +370,7 @@ private:
     Expression* gauss(std::vector<std::vector<Expression*>>) const;
 public:
     InverseMatrix(Expression* _matrix);
+    Expression* getMatrix() const noexcept;
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
     void destroy() noexcept override;
@@ -306,6 +383,7 @@ private:
     Expression* lowerUpperDecomposition(std::vector<std::vector<Expression*>> matrixExpression) const;
 public:
     MatrixLU(Expression* _matrix);
+    Expression* getMatrix() const noexcept;
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
     void destroy() noexcept override;
@@ -318,6 +396,7 @@ private:
     Expression* tridiagonal(std::vector<std::vector<Expression*>> matrix) const;
 public:
     TridiagonalMatrix(Expression* _matrix);
+    Expression* getMatrix() const noexcept;
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
     void destroy() noexcept override;
@@ -331,6 +410,7 @@ private:
     Expression* eigenvalues(std::vector<std::vector<Expression*>> matrix) const;
 public:
     RealEigenvalues(Expression* _matrix);
+    Expression* getMatrix() const noexcept;
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
     void destroy() noexcept override;
@@ -339,8 +419,10 @@ class Determinant : public Value
 {
 private:
     Expression* matrix;
+    Expression* determinant(Expression* input, Environment& env) const;
 public:
     Determinant(Expression* _matrix);
+    Expression* getMatrix() const noexcept;
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
     void destroy() noexcept override;
@@ -369,11 +451,90 @@ public:
     void destroy() noexcept override;
 };
 
+class Points : public Value
+{
+public:
+    struct Columns
+    {
+        std::vector<double> x;
+        std::vector<double> y;
+        // Barycentric weights of x, filled by the first INTERPOLATE of these points and shared by
+        // every copy. distinct is false when x has a repeated value and there are no weights
+        mutable std::once_flag interpolation;
+        mutable std::vector<double> weights;
+        mutable bool distinct = false;
+    };
+private:
+    std::shared_ptr<const Columns> columns;
+public:
+    Points(std::shared_ptr<const Columns> _columns);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    void print(std::string& out) const override;
+    std::shared_ptr<const Columns> getColumns() const noexcept;
+    // Reads (x, y) data from Points or a Vector of numeric Pairs, the value is not freed
+    static Expression* fromValue(Expression* value, std::shared_ptr<const Columns>& result);
+};
+
+class CreatePoints : public Expression
+{
+private:
+    Expression* vectorExpression;
+public:
+    CreatePoints(Expression* _vectorExpression);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    Expression* getExpression() const noexcept;
+    void destroy() noexcept override;
+};
+
+class LoadCsv : public Expression
+{
+private:
+    Expression* path;
+    Expression* layout;
+public:
+    LoadCsv(Expression* _path, Expression* _layout = nullptr);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    std::tuple<Expression*, Expression*> getExpressions() const noexcept;
+    void destroy() noexcept override;
+};
+
+class LoadNpy : public Expression
+{
+private:
+    Expression* path;
+public:
+    LoadNpy(Expression* _path);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    Expression* getExpression() const noexcept;
+    void destroy() noexcept override;
+};
+
+class SaveNpy : public Expression
+{
+private:
+    Expression* path;
+    Expression* matrix;
+public:
+    SaveNpy(Expression* _path, Expression* _matrix);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    std::tuple<Expression*, Expression*> getExpressions() const noexcept;
+    void destroy() noexcept override;
+};
+
 class Interpolate : public Expression
 {
 private:
     Expression* vectorExpression;
     Expression* numInter;
+    static std::vector<double> barycentricWeights(const std::vector<double>& x);
+    // False when the points have repeated x values
+    static bool prepare(const Points::Columns& columns);
+    static double barycentricEval(const std::vector<double>& x, const std::vector<double>& f, const std::vector<double>& w, double xa);
 public:
     Interpolate(Expression* _vectorExpression, Expression* _numInter);
     Expression* eval(Environment& env) const override;
@@ -382,19 +543,69 @@ public:
     void destroy() noexcept override;
 };
 
+class Spline : public Value
+{
+public:
+    enum class Kind
+    {
+        Linear,
+        Natural,
+        Clamped
+    };
+    struct Data
+    {
+        Kind kind;
+        std::vector<double> x;
+        std::vector<double> a;
+        std::vector<double> b;
+        std::vector<double> c;
+        std::vector<double> d;
+    };
+private:
+    std::shared_ptr<const Data> data;
+public:
+    Spline(std::shared_ptr<const Data> _data);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    double evalAt(double xa) const noexcept;
+};
+
+class CreateSpline : public Expression
+{
+private:
+    Expression* vectorExpression;
+    Expression* kind;
+public:
+    CreateSpline(Expression* _vectorExpression, Expression* _kind = nullptr);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    std::tuple<Expression*, Expression*> getExpressions() const noexcept;
+    void destroy() noexcept override;
+};
+
 class ODEFirstOrderInitialValues : public Expression
 {
+public:
+    using StepObserver = std::function<void(double, const double*, size_t)>;
 private:
     Expression* funct;
     Expression* initialValue;
     Expression* tFinal;
     Expression* variable;
-    Expression* rungekuttaMethod(double t, double x, double f, double h, Expression* function, Environment& env, Name* variable) const;
+    Expression* output;
+    Expression* openTrajectory(Environment& env, const std::vector<std::string>& columns, std::unique_ptr<TrajectoryWriter>& writer) const;
+    // Closes the trajectory file, result is replaced by an Impossible when the file could not be written
+    static Expression* closeTrajectory(std::unique_ptr<TrajectoryWriter>& writer, Expression* result);
+    Expression* rungekuttaMethod(double t, double x, double f, double h, Expression* function, Environment& env, Name* variable, const StepObserver& onStep = nullptr) const;
+    Expression* rungekuttaSystemMethod(double t, std::vector<double> x, double f, double h, Vector* functions, Environment& env, Vector* variables, const StepObserver& onStep = nullptr) const;
+    Expression* rungekuttaEnsembleMethod(std::vector<double> t, std::vector<double> x, double f, double h, Expression* function, Name* variable) const;
 public:
-    ODEFirstOrderInitialValues(Expression* _funct, Expression* _initialValue, Expression* _tFinal, Expression* _variable);
+    ODEFirstOrderInitialValues(Expression* _funct, Expression* _initialValue, Expression* _tFinal, Expression* _variable, Expression* _output = nullptr);
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
     std::tuple<Expression*, Expression*, Expression*, Expression*> getExpressions() const noexcept;
+    // The trajectory file, nullptr when the result is only returned
+    Expression* getOutput() const noexcept;
     void destroy() noexcept override;
 };
 
@@ -414,6 +625,53 @@ public:
     void destroy() noexcept override;
 };
 
+class FindRoot : public Expression
+{
+private:
+    Expression* interval;
+    Expression* function;
+    Expression* variable;
+    Expression* method;
+    Expression* tolerance;
+    Expression* newtonMethod(double left, double right, double tolerance, Expression* function, const std::string& variable, double& root) const;
+    Expression* secantMethod(double left, double right, double tolerance, PointEvaluator& f, double& root) const;
+public:
+    FindRoot(Expression* _interval, Expression* _function, Expression* _variable, Expression* _method = nullptr, Expression* _tolerance = nullptr);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    std::tuple<Expression*, Expression*, Expression*, Expression*, Expression*> getExpressions() const noexcept;
+    void destroy() noexcept override;
+    static Expression* brentMethod(double left, double right, double tolerance, PointEvaluator& f, double& root);
+};
+
+class AllRoots : public Expression
+{
+private:
+    Expression* interval;
+    Expression* function;
+    Expression* variable;
+    Expression* samples;
+public:
+    AllRoots(Expression* _interval, Expression* _function, Expression* _variable, Expression* _samples);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    std::tuple<Expression*, Expression*, Expression*, Expression*> getExpressions() const noexcept;
+    void destroy() noexcept override;
+};
+
+class Derivative : public Expression
+{
+private:
+    Expression* function;
+    Expression* variable;
+    Expression* point;
+public:
+    Derivative(Expression* _function, Expression* _variable, Expression* _point);
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    std::tuple<Expression*, Expression*, Expression*> getExpressions() const noexcept;
+    void destroy() noexcept override;
+};
 
 class Display : public Expression
 {
@@ -421,6 +679,7 @@ private:
     Expression* expression;
 public:
     Display(Expression* _expression);
+    Expression* getExpression() const noexcept;
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
     void destroy() noexcept override;
@@ -445,6 +704,10 @@ public:
     using BinaryExpression::BinaryExpression;
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
+    // Evaluates the value to assign without binding it. Returns nullptr and sets value, otherwise an Invalid
+    Expression* evalValue(Environment& env, Expression*& value) const;
+    // Binds a value from evalValue to the name, replacing the old value
+    void bind(Environment& env, Expression* value) const;
 };
 
 class ExpressionList : public Expression
@@ -456,9 +719,32 @@ public:
     ExpressionList();
     Expression* eval(Environment& env) const override;
     std::string toString() const noexcept override;
+    void print(std::string& out) const override;
     void addExpressionFront(Expression* expr);
     void addExpressionBack(Expression* expr);
     std::vector<Expression*> getVectorExpression() const;
     void destroy() noexcept override;
     size_t size() const noexcept {return sz;}
-};
\ No newline at end of file
+};
+
+// Parser accumulator for literals whose elements are all numeric constants, rows are stored contiguously
+class NumberList : public Expression
+{
+private:
+    std::vector<double> values;
+    size_t rows;
+    size_t columns;
+public:
+    NumberList();
+    Expression* eval(Environment& env) const override;
+    std::string toString() const noexcept override;
+    void addNumber(double value);
+    // Appends every row of another list, false when the widths differ
+    bool addRows(const NumberList& other);
+    const std::vector<double>& getValues() const noexcept;
+    size_t getRows() const noexcept;
+    size_t getColumns() const noexcept;
+    // Moves the values into a dense Matrix
+    Matrix* toMatrix();
+    void destroy() noexcept override;
+};
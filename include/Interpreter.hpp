@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string_view>
+
+#include "Expression.hpp"
+#include "ParseContext.hpp"
+
+// An interpreter with its own variables and parser, the entry point of libmpl. Instances are
+// independent, so each thread can run its own one; a single instance is not meant to be shared
+// between threads. The output settings (format, precision, elision) are the ones of Output.
+class Interpreter
+{
+private:
+    Environment env;
+    ParseContext context;
+    void execute(Expression* statement);
+    void reportParseError();
+    // The value of a variable assigned an expression of other variables, evaluated through its
+    // cache like a reference in a statement. nullptr for other variables, otherwise a new value
+    Expression* evalBinding(const std::string& name) const;
+public:
+    Interpreter();
+    ~Interpreter();
+    Interpreter(const Interpreter&) = delete;
+    Interpreter& operator=(const Interpreter&) = delete;
+
+    // Runs the statements of source one at a time and appends what they print to output. Returns
+    // false on a syntax error, the statements before it have run and output ends with the error
+    bool evaluate(std::string_view source, std::string& output);
+    // Parses the whole input before running it and writes the results at the end, like `mpl file`
+    bool run(FILE* input);
+    // Runs a program parsed by a ParseContext with the current variables. The program is only
+    // read, so several interpreters can run the same one at the same time
+    void run(const Expression& program);
+    // Runs every statement right after it is parsed, like `mpl --stream file`
+    bool stream(FILE* input);
+
+    void setNumber(const std::string& name, double value);
+    // False when the variable does not exist or is not a Number. Here and in getArray, a variable
+    // assigned an expression of other variables reads the value it evaluates to
+    bool getNumber(const std::string& name, double& value) const;
+    void setVector(const std::string& name, const double* values, size_t size);
+    // values is read row by row
+    void setMatrix(const std::string& name, const double* values, size_t rows, size_t columns);
+    // Copies a numeric Vector (shape {size}) or Matrix (shape {rows, columns}) row by row.
+    // False when the variable does not exist or has elements that are not numbers
+    bool getArray(const std::string& name, std::vector<double>& values, std::vector<size_t>& shape) const;
+    // Forgets every variable
+    void reset();
+    const Environment& getEnvironment() const noexcept;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "utils.hpp"
+
+enum class MemoOperation : uint8_t
+{
+    Determinant,
+    Inverse,
+    RealEigenvalues,
+    Integral
+};
+
+// Results of the pure builtins, keyed by the operation and the evaluated arguments. The key holds
+// the arguments themselves (dense matrices as their raw buffer), so equal keys mean equal inputs.
+// Disabled until a byte budget is set, then the least recently used results are dropped to stay
+// within it. Shared by every thread.
+// A directory can also keep the results between runs, one file per result named by a hash of the
+// key and the interpreter version. The values are mapped from the file on a hit, and the files
+// used least recently are removed beyond a size limit.
+class MemoCache
+{
+private:
+    struct Entry
+    {
+        std::string key;
+        Expression* value;
+        size_t bytes;
+    };
+    // Most recently used first, the index points into the entries so keys are stored once
+    std::list<Entry> entries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    std::atomic<size_t> budget;
+    size_t bytes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t diskHits;
+    mutable std::mutex mutex;
+    std::string directory;
+    size_t diskLimit;
+    std::atomic<bool> persistent;
+    // Sum of the file sizes as of the last scan plus the files written since
+    std::atomic<size_t> diskBytes;
+    std::mutex diskMutex;
+    MemoCache();
+    void evict(size_t limit);
+    void remember(std::string key, const Expression& result);
+    Expression* load(const std::string& key);
+    void save(const std::string& key, const Expression& result);
+    void trim(size_t limit);
+public:
+    MemoCache(const MemoCache&) = delete;
+    MemoCache& operator=(const MemoCache&) = delete;
+    ~MemoCache();
+    static MemoCache& instance();
+    // 0 disables the cache and frees its results
+    void setBudget(size_t _budget);
+    size_t getBudget() const noexcept;
+    bool isEnabled() const noexcept;
+    // Keeps the results in directory as well, it is created when missing. Call before any
+    // evaluation. False when the directory can not be used
+    bool setDirectory(std::string path, size_t limit);
+    // A copy of the cached result of operation on the evaluated arguments, or nullptr. On a miss
+    // key is set for store, it stays empty when the cache is disabled or an argument has no key
+    Expression* find(MemoOperation operation, std::initializer_list<Expression*> arguments, std::string& key);
+    // Keeps a copy of a result under a key from find. Only numbers and vectors or matrices of
+    // numbers are kept
+    void store(std::string key, const Expression& result);
+    uint64_t getHits() const noexcept;
+    uint64_t getMisses() const noexcept;
+    // Hits that were read from the directory, they are also counted in getHits
+    uint64_t getDiskHits() const noexcept;
+    size_t getBytes() const noexcept;
+    size_t size() const noexcept;
+    void clear();
+};
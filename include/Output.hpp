@@ -0,0 +1,55 @@
+#pragma once
+
+#include "utils.hpp"
+
+// Appends value in fixed notation with the configured number of decimals, like std::to_string
+// does with the default precision of 6, without allocating a temporary string
+void appendNumber(std::string& out, double value);
+
+enum class OutputFormat
+{
+    Text,
+    Jsonl,
+    Binary,
+    Csv
+};
+
+// Everything the interpreter prints goes through the C stdout buffer, so writes from printf,
+// std::cout and this class stay in order. When stdout is not a terminal the buffer is large and
+// only flushed when full or at exit. A thread can send its writes to a string instead, which is
+// how embedded interpreters collect their output. The settings are shared by every thread.
+class Output
+{
+private:
+    OutputFormat format;
+    int precision;
+    size_t elision;
+    static thread_local std::string scratch;
+    static thread_local std::string* sink;
+    Output();
+public:
+    static constexpr int MAX_PRECISION = 30;
+    static Output& instance();
+    // Jsonl writes one JSON object per value, Csv one line of cells per value and Binary the
+    // records described in the README
+    void setFormat(OutputFormat _format) noexcept;
+    OutputFormat getFormat() const noexcept;
+    void setPrecision(int digits) noexcept;
+    int getPrecision() const noexcept;
+    // Vectors and matrices with more than limit elements per dimension show only both ends, 0 disables it
+    void setElision(size_t limit) noexcept;
+    size_t getElision() const noexcept;
+    // Writes of the calling thread are appended to target, nullptr goes back to stdout
+    void setSink(std::string* target) noexcept;
+    std::string* getSink() const noexcept;
+    void write(std::string_view text);
+    // Writes the text of a value, reusing one buffer for every call
+    void write(const Expression& value);
+    // Writes a displayed value as a text line or as a record of the selected format
+    void writeLine(const Expression& value);
+    // A failure that is not a value, like a syntax error. Text mode writes the text as it is
+    void writeError(std::string_view type, std::string_view text);
+    // A message of print: a line of text, a Print JSON object, a text record or a quoted CSV cell
+    void writeMessage(std::string_view text);
+    void flush();
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdio>
+#include <unordered_set>
+
+#include "Expression.hpp"
+
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+// Everything a parse needs: the scanner, the nodes built so far and the result. The parser and the
+// scanner keep no globals, so every thread can parse with its own context at the same time
+class ParseContext
+{
+public:
+    ParseContext();
+    ~ParseContext();
+    ParseContext(const ParseContext&) = delete;
+    ParseContext& operator=(const ParseContext&) = delete;
+
+    // Parses input until its end and returns 0 on success, like yyparse. After a failure the
+    // nodes already built are deleted and error holds the syntax error message
+    int parse(FILE* input);
+
+    yyscan_t scanner;
+    Expression* result;
+    // Nodes that belong to the statement being parsed, deleted if the parse fails
+    std::unordered_set<Expression*> pointers;
+    // When set, every statement is handed over as soon as it is parsed instead of being collected
+    std::function<void(Expression*)> statement_handler;
+    std::string error;
+
+    // Scanner state
+    int num_column;
+    std::string id;
+    std::string assing_id;
+    bool take;
+};
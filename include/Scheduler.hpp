@@ -0,0 +1,21 @@
+#pragma once
+
+#include "utils.hpp"
+
+// Runs the statements of a program on the thread pool. A statement depends on the last statements
+// that assigned the names it reads, directly or through the values of other names, and an
+// assignment waits for the earlier reads of its name. Statements are grouped in levels of that
+// graph: the statements of a level run at the same time against the same variables, then their
+// assignments are applied and their output is written in program order. Statements that write
+// files (SAVENPY, ODE trajectories) have a level of their own.
+class Scheduler
+{
+private:
+    std::vector<Expression*> statements;
+    std::vector<std::vector<size_t>> levels;
+    void analyze();
+public:
+    Scheduler(std::vector<Expression*> _statements);
+    // Evaluates every statement and returns an ExpressionList with their results in program order
+    Expression* run(Environment& env) const;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+#include "utils.hpp"
+
+// Frames exchanged over the socket, integers and doubles in the native byte order (little endian
+// on x86). A connection carries any number of requests, each one answered before the next is read.
+//   request:  u32 script size, u32 binding count, script bytes, then per binding
+//             u32 name size, name bytes, u8 dimensions, u64 per dimension, f64 values row by row
+//   response: u32 status, u32 output size, output bytes
+// A binding without dimensions is a Number, with one a Vector and with two a Matrix.
+enum class ServerStatus : uint32_t
+{
+    Ok = 0,
+    SyntaxError = 1,
+    Failed = 2
+};
+
+struct ServerBinding
+{
+    std::string name;
+    std::vector<size_t> shape;
+    std::vector<double> values;
+};
+
+struct ServerRequest
+{
+    std::string script;
+    std::vector<ServerBinding> bindings;
+};
+
+struct ServerResponse
+{
+    ServerStatus status;
+    std::string output;
+};
+
+void encodeRequest(const ServerRequest& request, std::string& out);
+void encodeResponse(const ServerResponse& response, std::string& out);
+// False at the end of the stream or when the frame is malformed
+bool readRequest(int fd, ServerRequest& request);
+bool readResponse(int fd, ServerResponse& response);
+bool writeAll(int fd, std::string_view data);
+
+// Evaluates requests from a Unix socket. Every worker keeps one warm Interpreter and takes one
+// request at a time from whichever connection has one ready, resetting the variables before each
+// request so requests stay isolated. Idle connections wait in the accepting thread, so they never
+// hold a worker.
+class Server
+{
+private:
+    std::string path;
+    size_t workerCount;
+    int listener;
+    // Written by the workers to wake up the accepting thread when a connection is idle again
+    int wakeup[2];
+    std::vector<std::thread> workers;
+    // Connections with a request to read, and connections handed back by the workers
+    std::queue<int> ready;
+    std::vector<int> returned;
+    std::unordered_set<int> active;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+    void workerLoop();
+public:
+    Server(std::string _path, size_t _workers);
+    ~Server();
+    // Accepts connections until SIGINT or SIGTERM, returns EXIT_FAILURE if the socket cannot be used
+    int run();
+};
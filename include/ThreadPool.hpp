@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#include "utils.hpp"
+
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+    void workerLoop();
+public:
+    ThreadPool(size_t threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+    void submit(std::function<void()> task);
+    // Runs task(i) for every i in [0, count). The calling thread takes part in the work,
+    // so nested calls from inside a task cannot deadlock the pool.
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+    size_t size() const noexcept;
+    static ThreadPool& instance();
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <iostream>
+#include <algorithm>
+#include <cstdio>
 #include <cmath>
 #include <memory>
 #include <vector>
@@ -18,7 +20,10 @@ enum class DataType
     Vector,
     Matrix,
     Number,
-    Name
+    Name,
+    String,
+    Spline,
+    Points
 };
 
 class Expression;
@@ -27,4 +32,63 @@ class Expression;
 using Environment = std::forward_list<std::pair<std::string, Expression*>>;
 
 std::string dataTypeToString(DataType);
+// Calls visit on expr and on the expressions inside it, skipping the inside of a node when visit returns false
+void forEachNode(Expression* expr, const std::function<bool(Expression*)>& visit);
 bool containsName(Expression* expr, const std::string& varName, Environment& env) noexcept;
+
+struct Dual
+{
+    double value;
+    double derivative;
+};
+
+// Forward-mode differentiation: evaluates expr and d(expr)/d(varName) at varName = at in a single pass.
+// Returns nullptr on success, otherwise an Invalid/Impossible explaining why it could not be evaluated.
+Expression* evalDual(Expression* expr, const std::string& varName, double at, Dual& result) noexcept;
+
+// Evaluates a function of one variable at many points, rebinding a single environment slot
+// instead of growing the environment on every call
+class PointEvaluator
+{
+private:
+    Expression* function;
+    Environment env;
+public:
+    PointEvaluator(Expression* _function, const std::string& variable);
+    PointEvaluator(const PointEvaluator&) = delete;
+    PointEvaluator& operator=(const PointEvaluator&) = delete;
+    ~PointEvaluator();
+    // Returns nullptr and sets y on success, otherwise an Invalid
+    Expression* operator()(double x, double& y);
+};
+
+// Buffered writer for ODE trajectories: CSV text, or raw native doubles when the path ends in ".bin"
+class TrajectoryWriter
+{
+private:
+    std::string path;
+    std::FILE* file;
+    bool binary;
+    bool failed;
+    std::string buffer;
+    void flush();
+public:
+    TrajectoryWriter(const std::string& path, const std::vector<std::string>& columns);
+    ~TrajectoryWriter();
+    bool isOpen() const noexcept;
+    const std::string& getPath() const noexcept;
+    void write(double t, const double* x, size_t n);
+    // Writes what is left and closes the file, false when any write or the close failed
+    bool close();
+};
+
+// Streams a numeric CSV file into row-major values, a single header line is skipped.
+// Returns nullptr on success, otherwise an Invalid
+Expression* readCsv(const std::string& path, std::vector<double>& values, size_t& rows, size_t& columns) noexcept;
+
+// Maps a float64 C-order .npy file read-only, the mapping lives as long as the returned data.
+// Returns nullptr on success, otherwise an Invalid
+Expression* mapNpy(const std::string& path, std::shared_ptr<const double>& data, size_t& rows, size_t& columns) noexcept;
+
+// Writes row-major values as a float64 C-order .npy file. Returns nullptr on success, otherwise an Invalid
+Expression* writeNpy(const std::string& path, const double* data, size_t rows, size_t columns) noexcept;
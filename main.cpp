@@ -5,35 +5,37 @@
 #include <vector>
 #include <forward_list>
 #include <memory>
-#include <unordered_set>
+#include <charconv>
+#include <cctype>
+#include <atomic>
+#include <condition_variable>
+#include <future>
 #include <Expression.hpp>
+#include <Output.hpp>
+#include <Interpreter.hpp>
+#include <Server.hpp>
+#include <MemoCache.hpp>
 
 #define Function ReadlineFunctionWrapper
 #include <readline/readline.h>
 #include <readline/history.h>
 #undef Function
 
-extern FILE* yyin;
-extern int yyparse();
-extern Expression* parser_result;
-extern void yyrestart(FILE* input);
-extern int yylex_destroy();
-extern std::unordered_set<Expression*> pointers;
-
 const std::string GREEN = "\e[32m";
 const std::string RED = "\e[31m";
 const std::string GREEN_BOLD = "\e[1;92m";
 const std::string RED_BOLD = "\e[1;91m";
 const std::string COLOR_OFF = "\e[0m";
 
-static Environment* current_env = nullptr;
+static const Environment* current_env = nullptr;
 static const std::vector<std::string> keywords = {
     "print", "display",
     "+", "-", "*", "/", "^",
     "LOG", "LN", "SQRT", "ROOT",
     "SIN", "COS", "TAN", "CTG", "INVERSE",
     "MATRIXLU", "TRIDIAGONAL", "REALEIGENVALUES", "DETERMINANT",
-    "BISECTIONROOT", "INTEGRAL", "ODEFIRST", "INTERPOLATE",
+    "BISECTIONROOT", "INTEGRAL", "ODEFIRST", "INTERPOLATE", "DERIVATIVE",
+    "FINDROOT", "ALLROOTS", "SPLINE", "POINTS", "LOADCSV", "LOADNPY", "SAVENPY",
     "PI", "EULER",
     "(", ")", "[", "]", "{", "}", ",", ";", "=",
     "exit"
@@ -130,74 +132,544 @@ std::string_view trim(std::string_view str)
 
 void usage(char* argv[])
 {
-    std::cout << "Usage 1: " << argv[0] << " input_file" << std::endl;
-    std::cout << "Usage 2: " << argv[0] << std::endl;
+    std::cout << "Usage 1: " << argv[0] << " [options] input_file" << std::endl;
+    std::cout << "Usage 2: " << argv[0] << " [options] --stream input_file" << std::endl;
+    std::cout << "Usage 3: " << argv[0] << " [options] -" << std::endl;
+    std::cout << "Usage 4: " << argv[0] << " [options]" << std::endl;
+    std::cout << "Usage 5: " << argv[0] << " [options] --serve socket_path" << std::endl;
+    std::cout << "Usage 6: " << argv[0] << " [options] input_file input_file..." << std::endl;
+    std::cout << "Usage 7: " << argv[0] << " [options] --sweep \"B=1:1000:1,k=[0.1,0.2]\" input_file" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --precision=N  decimals printed for numbers (default 6)" << std::endl;
+    std::cout << "  --elide=N      show only the ends of vectors and matrices longer than N" << std::endl;
+    std::cout << "  --output=F     text (default), jsonl, csv or binary results" << std::endl;
+    std::cout << "  --jobs=N       scripts or requests evaluated in parallel (default: one per core)" << std::endl;
+    std::cout << "  --memo=N[K|M|G]  keep up to N bytes of DETERMINANT, INVERSE, REALEIGENVALUES and INTEGRAL results" << std::endl;
+    std::cout << "  --memo-stats   print the hits and misses of --memo to stderr at exit" << std::endl;
+    std::cout << "  --cache-dir=D  also keep those results in directory D between runs" << std::endl;
+    std::cout << "  --cache-size=N[K|M|G]  size limit of --cache-dir (default 1G)" << std::endl;
     exit(1);
 }
 
-int main(int argc, char* argv[])
+// Reads the number after a "--name=" option, exits with the usage when it is not one
+size_t option_value(std::string_view arg, char* argv[])
 {
+    size_t value = 0;
+    auto text = arg.substr(arg.find('=') + 1);
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || ec != std::errc{} || end != text.data() + text.size())
+    {
+        usage(argv);
+    }
+    return value;
+}
 
-    if (argc == 2)
+// Reads a size like 64M after a "--name=" option, exits with the usage when it is not one
+size_t option_bytes(std::string_view arg, char* argv[])
+{
+    size_t shift = 0;
+    switch (arg.empty() ? '\0' : std::toupper(static_cast<unsigned char>(arg.back())))
     {
-        yyin = fopen(argv[1], "r");
+    case 'K':
+        shift = 10;
+        break;
+    case 'M':
+        shift = 20;
+        break;
+    case 'G':
+        shift = 30;
+        break;
+    }
+    if (shift != 0)
+    {
+        arg.remove_suffix(1);
+    }
+    size_t value = option_value(arg, argv);
+    if (value > (std::numeric_limits<size_t>::max() >> shift))
+    {
+        usage(argv);
+    }
+    return value << shift;
+}
 
-        if (!yyin)
+void print_memo_stats()
+{
+    auto& memo = MemoCache::instance();
+    std::cerr << "Memo cache: " << memo.getHits() << " hits (" << memo.getDiskHits() << " from disk), " << memo.getMisses() << " misses, "
+              << memo.size() << " results in " << memo.getBytes() << " bytes" << std::endl;
+}
+
+// Reads the format after "--output=", exits with the usage when it is not known
+OutputFormat output_format(std::string_view arg, char* argv[])
+{
+    auto text = arg.substr(arg.find('=') + 1);
+    if (text == "text")
+    {
+        return OutputFormat::Text;
+    }
+    else if (text == "jsonl")
+    {
+        return OutputFormat::Jsonl;
+    }
+    else if (text == "binary")
+    {
+        return OutputFormat::Binary;
+    }
+    else if (text == "csv")
+    {
+        return OutputFormat::Csv;
+    }
+    usage(argv);
+    return OutputFormat::Text;
+}
+
+// Runs task(i) for every i in [0, count) on jobs threads, each thread with its own Interpreter.
+// What a task writes is collected and written once every earlier task is done, so the output
+// keeps the order of i
+void run_ordered(size_t count, size_t jobs, const std::function<void(size_t, Interpreter&, std::string&)>& task)
+{
+    std::vector<std::string> outputs(count);
+    std::vector<bool> finished(count, false);
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::atomic<size_t> next{0};
+
+    auto work = [&]()
+    {
+        Interpreter interpreter;
+        for (size_t i = next++; i < count; i = next++)
         {
-            std::cout << "Could not open " << argv[1] << std::endl;
-            exit(1);
+            std::string text;
+            Output::instance().setSink(&text);
+            interpreter.reset();
+            task(i, interpreter, text);
+            Output::instance().setSink(nullptr);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                outputs[i] = std::move(text);
+                finished[i] = true;
+            }
+            ready.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers{};
+    for (size_t j = 0; j < std::clamp<size_t>(jobs, 1, std::max<size_t>(count, 1)); ++j)
+    {
+        workers.emplace_back(work);
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [&finished, i] { return finished[i]; });
+        std::string text = std::move(outputs[i]);
+        lock.unlock();
+        Output::instance().write(text);
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Runs every file with its own variables, the outputs keep the order of the arguments
+int run_files(const std::vector<char*>& files, size_t jobs, bool stream)
+{
+    std::atomic<bool> failed{false};
+    run_ordered(files.size(), jobs, [&files, &failed, stream](size_t i, Interpreter& interpreter, std::string&)
+    {
+        FILE* input = strcmp(files[i], "-") == 0 ? stdin : fopen(files[i], "r");
+        if (!input)
+        {
+            // A record like the other failures, so jsonl, csv and binary outputs stay readable
+            Output::instance().writeError("FileError", "Could not open " + std::string(files[i]));
+            failed = true;
+            return;
         }
+        bool parsed = stream ? interpreter.stream(input) : interpreter.run(input);
+        if (input != stdin)
+        {
+            fclose(input);
+        }
+        if (!parsed)
+        {
+            failed = true;
+        }
+    });
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// A variable of a sweep and the values it takes
+struct SweepAxis
+{
+    std::string name;
+    std::vector<double> values;
+};
 
-        int result = yyparse();
+void append_shortest(std::string& out, double value)
+{
+    char text[32];
+    auto [end, ec] = std::to_chars(text, text + sizeof(text), value);
+    out.append(text, end);
+}
+
+bool parse_number(std::string_view text, double& value)
+{
+    text = trim(text);
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && ec == std::errc{} && end == text.data() + text.size();
+}
 
-        if (result == 0)
+// Reads "B=1:1000:1,k=[0.1,0.2],c=3": a range start:stop[:step] with stop included, a list or a
+// single value per variable
+bool parse_sweep(std::string_view spec, std::vector<SweepAxis>& axes)
+{
+    size_t depth = 0;
+    size_t start = 0;
+    for (size_t i = 0; i <= spec.size(); ++i)
+    {
+        if (i < spec.size() && (spec[i] != ',' || depth > 0))
         {
-            auto env = Environment();
-            auto exs = dynamic_cast<ExpressionList*>(parser_result);
-            std::unique_ptr<Expression> res(exs->eval(env));
-            std::cout << res->toString();
-            res->destroy();
-            exs->destroy();
-            for (auto& t : env)
+            depth += (spec[i] == '[') ? 1 : 0;
+            depth -= (spec[i] == ']' && depth > 0) ? 1 : 0;
+            continue;
+        }
+        auto item = spec.substr(start, i - start);
+        start = i + 1;
+        auto equal = item.find('=');
+        if (equal == std::string_view::npos || trim(item.substr(0, equal)).empty())
+        {
+            return false;
+        }
+        SweepAxis axis{std::string(trim(item.substr(0, equal))), {}};
+        auto values = trim(item.substr(equal + 1));
+        double value = 0;
+        if (values.size() >= 2 && values.front() == '[' && values.back() == ']')
+        {
+            values = values.substr(1, values.size() - 2);
+            for (size_t from = 0; from <= values.size();)
             {
-                if (t.second != nullptr)
+                size_t to = std::min(values.find(',', from), values.size());
+                if (!parse_number(values.substr(from, to - from), value))
                 {
-                    t.second->destroy();
-                    delete t.second;
-                    t.second = nullptr;
+                    return false;
                 }
+                axis.values.push_back(value);
+                from = to + 1;
+            }
+        }
+        else if (auto colon = values.find(':'); colon != std::string_view::npos)
+        {
+            auto second = values.find(':', colon + 1);
+            double first = 0;
+            double last = 0;
+            double step = 1;
+            if (!parse_number(values.substr(0, colon), first) ||
+                !parse_number(values.substr(colon + 1, second - colon - 1), last) ||
+                (second != std::string_view::npos && !parse_number(values.substr(second + 1), step)) ||
+                step == 0 || (last - first) / step < 0)
+            {
+                return false;
+            }
+            // Computed from the index so the error does not add up along the range
+            size_t count = static_cast<size_t>(std::floor((last - first) / step + 1e-9)) + 1;
+            for (size_t j = 0; j < count; ++j)
+            {
+                axis.values.push_back(first + j * step);
             }
         }
+        else if (parse_number(values, value))
+        {
+            axis.values.push_back(value);
+        }
         else
         {
-            std::cout << "Parse failed!" << std::endl;
+            return false;
+        }
+        axes.push_back(std::move(axis));
+    }
+    return !axes.empty();
+}
 
-            for (Expression* expr : pointers)
+// Parses the script once and runs it for every combination of the swept values, the last
+// variable changing fastest. Each combination gives one CSV row or JSON line with its values
+// followed by the displayed results
+int run_sweep(const std::vector<SweepAxis>& axes, FILE* input, size_t jobs)
+{
+    auto& output = Output::instance();
+    ParseContext context;
+    int status = context.parse(input);
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+    if (status != 0)
+    {
+        output.writeError("SyntaxError", context.error);
+        output.writeError("ParseError", "Parse failed!");
+        return EXIT_FAILURE;
+    }
+    std::unique_ptr<Expression> program(context.result);
+    context.result = nullptr;
+
+    size_t combinations = 1;
+    for (const auto& axis : axes)
+    {
+        combinations *= axis.values.size();
+    }
+    bool json = output.getFormat() == OutputFormat::Jsonl;
+    // The first combination is always taken first, so waiting for its width cannot block
+    std::promise<size_t> width;
+    std::shared_future<size_t> header_cells = width.get_future().share();
+    std::atomic<bool> failed{false};
+
+    run_ordered(combinations, jobs, [&](size_t c, Interpreter& interpreter, std::string& text)
+    {
+        std::string record = json ? "{" : "";
+        size_t rest = combinations;
+        for (const auto& axis : axes)
+        {
+            rest /= axis.values.size();
+            double value = axis.values[(c / rest) % axis.values.size()];
+            interpreter.setNumber(axis.name, value);
+            record += json ? "\"" + axis.name + "\":" : "";
+            append_shortest(record, value);
+            record += ",";
+        }
+        interpreter.run(*program);
+
+        // Every result ends with an unquoted newline, one JSON object or a group of CSV cells.
+        // Quoted CSV text, like a symbolic matrix, can hold newlines and commas of its own, and
+        // JSON strings can hold escaped quotes
+        size_t cells = 0;
+        bool quoted = false;
+        record += json ? "\"results\":[" : "";
+        for (size_t from = 0, i = 0; i < text.size(); ++i)
+        {
+            if (json && quoted && text[i] == '\\')
             {
-                if (expr != nullptr)
-                {
-                    delete expr;
-                    expr = nullptr;
-                }
+                ++i;
+                continue;
+            }
+            quoted = quoted != (text[i] == '"');
+            cells += (text[i] == ',' && !quoted) ? 1 : 0;
+            if (text[i] == '\n' && !quoted)
+            {
+                ++cells;
+                record.append(text, from, i - from);
+                record += ",";
+                from = i + 1;
             }
+        }
+        if (!json || cells > 0)
+        {
+            record.pop_back();
+        }
+        record += json ? "]}\n" : "\n";
+        text = std::move(record);
+        if (json)
+        {
+            return;
+        }
 
-            pointers.clear();
+        // The header is named after the first row, a row with another number of cells is
+        // reported instead of being written under the wrong columns
+        if (c == 0)
+        {
+            std::string header{};
+            for (const auto& axis : axes)
+            {
+                header += axis.name + ",";
+            }
+            for (size_t i = 1; i <= cells; ++i)
+            {
+                header += "result" + std::to_string(i) + ",";
+            }
+            header.pop_back();
+            text = header + "\n" + text;
+            width.set_value(cells);
         }
+        else if (size_t expected = header_cells.get(); cells != expected)
+        {
+            text.clear();
+            output.writeError("SweepError", "Combination " + std::to_string(c + 1) + " gave " + std::to_string(cells) + " cells instead of " + std::to_string(expected));
+            failed = true;
+        }
+    });
+
+    program->destroy();
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
 
-        return EXIT_SUCCESS;
+int main(int argc, char* argv[])
+{
+    // Set up the output buffer before anything is printed
+    auto& output = Output::instance();
+    bool stream = false;
+    char* serve_path = nullptr;
+    std::vector<SweepAxis> sweep{};
+    size_t jobs = std::thread::hardware_concurrency();
+    std::string cache_dir{};
+    size_t cache_size = size_t{1} << 30;
+    std::vector<char*> files{};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--stream")
+        {
+            stream = true;
+        }
+        else if (arg.rfind("--precision=", 0) == 0)
+        {
+            output.setPrecision(static_cast<int>(std::min<size_t>(option_value(arg, argv), Output::MAX_PRECISION)));
+        }
+        else if (arg.rfind("--elide=", 0) == 0)
+        {
+            output.setElision(option_value(arg, argv));
+        }
+        else if (arg == "--sweep" && i + 1 < argc)
+        {
+            if (!parse_sweep(argv[++i], sweep))
+            {
+                std::cout << "Invalid sweep: " << argv[i] << std::endl;
+                usage(argv);
+            }
+        }
+        else if (arg == "--serve" && i + 1 < argc)
+        {
+            serve_path = argv[++i];
+        }
+        else if (arg.rfind("--jobs=", 0) == 0)
+        {
+            jobs = option_value(arg, argv);
+        }
+        else if (arg == "--jobs" && i + 1 < argc)
+        {
+            jobs = option_value(std::string("--jobs=") + argv[++i], argv);
+        }
+        else if (arg.rfind("--output=", 0) == 0)
+        {
+            output.setFormat(output_format(arg, argv));
+        }
+        else if (arg.rfind("--memo=", 0) == 0)
+        {
+            MemoCache::instance().setBudget(option_bytes(arg, argv));
+        }
+        else if (arg == "--memo-stats")
+        {
+            // The cache is created before the handler is registered, so it is destroyed after it runs
+            MemoCache::instance();
+            std::atexit(print_memo_stats);
+        }
+        else if (arg.rfind("--cache-dir=", 0) == 0)
+        {
+            cache_dir = arg.substr(arg.find('=') + 1);
+        }
+        else if (arg == "--cache-dir" && i + 1 < argc)
+        {
+            cache_dir = argv[++i];
+        }
+        else if (arg.rfind("--cache-size=", 0) == 0)
+        {
+            cache_size = option_bytes(arg, argv);
+        }
+        else if (arg.size() > 1 && arg[0] == '-')
+        {
+            usage(argv);
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
     }
-    else if(argc > 2)
+
+    if ((stream && files.empty()) || (serve_path != nullptr && !files.empty()))
     {
         usage(argv);
     }
 
+    if (!cache_dir.empty() && !MemoCache::instance().setDirectory(cache_dir, cache_size))
+    {
+        std::cout << "Could not use cache directory " << cache_dir << std::endl;
+        exit(1);
+    }
+
+    if (!sweep.empty())
+    {
+        if (files.size() != 1 || stream || serve_path != nullptr || output.getFormat() == OutputFormat::Binary)
+        {
+            usage(argv);
+        }
+        FILE* input = strcmp(files[0], "-") == 0 ? stdin : fopen(files[0], "r");
+
+        if (!input)
+        {
+            std::cout << "Could not open " << files[0] << std::endl;
+            exit(1);
+        }
+
+        // Rows of cells unless JSON lines were asked for
+        if (output.getFormat() == OutputFormat::Text)
+        {
+            output.setFormat(OutputFormat::Csv);
+        }
+        return run_sweep(sweep, input, jobs);
+    }
+
+    if (serve_path != nullptr)
+    {
+        Server server(serve_path, jobs);
+        return server.run();
+    }
+
+    if (files.size() > 1)
+    {
+        return run_files(files, jobs, stream);
+    }
+    else if (files.size() == 1 && (stream || strcmp(files[0], "-") == 0))
+    {
+        FILE* input = strcmp(files[0], "-") == 0 ? stdin : fopen(files[0], "r");
+
+        if (!input)
+        {
+            std::cout << "Could not open " << files[0] << std::endl;
+            exit(1);
+        }
+
+        Interpreter interpreter;
+        bool parsed = interpreter.stream(input);
+        if (input != stdin)
+        {
+            fclose(input);
+        }
+        return parsed ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (files.size() == 1)
+    {
+        FILE* input = fopen(files[0], "r");
+
+        if (!input)
+        {
+            std::cout << "Could not open " << files[0] << std::endl;
+            exit(1);
+        }
+
+        Interpreter interpreter;
+        bool parsed = interpreter.run(input);
+        fclose(input);
+
+        return parsed ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     std::cout << "Interactive Interpreter for Mathematical Programming Language\n"
               << "Type 'exit' to quit or press Ctrl+D\n\n";
 
     rl_attempted_completion_function = completion;
 
-    Environment env;
-    current_env = &env;
+    Interpreter interpreter;
+    std::string text;
+    current_env = &interpreter.getEnvironment();
 
     size_t counter = 1;
 
@@ -224,75 +696,24 @@ int main(int argc, char* argv[])
             continue;
         }
 
-        yyin = fmemopen((void*)prog.c_str(), prog.size(), "r");
-        if (!yyin)
+        text.clear();
+        try
         {
-            std::cerr << get_error_prompt("Internal error") << "Failed to create memory stream\n\n";
-            continue;
-        }
-
-        int result = yyparse();
-        fclose(yyin);
-        yyin = nullptr;
-
-        if (result == 0)
-        {
-            try
+            if (interpreter.evaluate(prog, text))
             {
-                auto exs = dynamic_cast<ExpressionList*>(parser_result);
-                if (exs)
-                {
-                    std::unique_ptr<Expression> res(exs->eval(env));
-                    std::cout << get_output_prompt(counter) << res->toString() << "\n\n";
-                    res->destroy();
-                }
-                else
-                {
-                    std::cerr << get_error_prompt("Evaluation error") << "Expected ExpressionList\n\n";
-                }
-
+                std::cout << get_output_prompt(counter) << text << "\n\n";
                 add_history(prog.c_str());
                 ++counter;
             }
-            catch (const std::exception& e)
-            {
-                std::cerr << get_error_prompt("Runtime error") << e.what() << "\n\n";
-            }
-
-            if (parser_result)
-            {
-                parser_result->destroy();
-                delete parser_result;
-                parser_result = nullptr;
-            }
-        }
-        else
-        {
-            std::cerr << get_error_prompt("Parse error") << "Invalid syntax\n\n";
-
-            for (Expression* expr : pointers)
+            else
             {
-                if (expr != nullptr)
-                {
-                    delete expr;
-                    expr = nullptr;
-                }
+                std::cout << text;
+                std::cerr << get_error_prompt("Parse error") << "Invalid syntax\n\n";
             }
-
-            yyrestart(nullptr);
-            yylex_destroy();
         }
-
-        pointers.clear();
-    }
-
-    for (auto& t : env)
-    {
-        if (t.second != nullptr)
+        catch (const std::exception& e)
         {
-            t.second->destroy();
-            delete t.second;
-            t.second = nullptr;
+            std::cerr << get_error_prompt("Runtime error") << e.what() << "\n\n";
         }
     }
 
@@ -1,6 +1,110 @@
 #include <Expression.hpp>
+#include <ThreadPool.hpp>
+#include <Output.hpp>
+#include <Scheduler.hpp>
+#include <MemoCache.hpp>
 
 Expression::~Expression() {}
+void Expression::print(std::string& out) const
+{
+    out += toString();
+}
+
+namespace
+{
+    // Calls item(i) for every index that is shown when printing count elements, and gap() once
+    // in place of the ones skipped by the output elision limit
+    template <typename Item, typename Gap>
+    void forEachShown(size_t count, Item item, Gap gap)
+    {
+        size_t limit = Output::instance().getElision();
+        if (limit == 0 || count <= limit)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                item(i);
+            }
+            return;
+        }
+        for (size_t i = 0; i < (limit + 1) / 2; ++i)
+        {
+            item(i);
+        }
+        gap();
+        for (size_t i = count - limit / 2; i < count; ++i)
+        {
+            item(i);
+        }
+    }
+
+    // Rough cost of one numerical method, matrix function or file load, in evaluations of an
+    // arithmetic node
+    constexpr size_t NUMERIC_METHOD_COST = 1000;
+    // An element estimated to cost at least this is worth a task of its own
+    constexpr size_t PARALLEL_ELEMENT_COST = 1000;
+
+    bool isNumericMethod(Expression* node)
+    {
+        return dynamic_cast<Integral*>(node) != nullptr || dynamic_cast<ODEFirstOrderInitialValues*>(node) != nullptr ||
+               dynamic_cast<FindRootBisection*>(node) != nullptr || dynamic_cast<FindRoot*>(node) != nullptr ||
+               dynamic_cast<AllRoots*>(node) != nullptr || dynamic_cast<Derivative*>(node) != nullptr ||
+               dynamic_cast<InverseMatrix*>(node) != nullptr || dynamic_cast<MatrixLU*>(node) != nullptr ||
+               dynamic_cast<TridiagonalMatrix*>(node) != nullptr || dynamic_cast<RealEigenvalues*>(node) != nullptr ||
+               dynamic_cast<Determinant*>(node) != nullptr || dynamic_cast<Interpolate*>(node) != nullptr ||
+               dynamic_cast<CreateSpline*>(node) != nullptr || dynamic_cast<LoadCsv*>(node) != nullptr ||
+               dynamic_cast<LoadNpy*>(node) != nullptr;
+    }
+
+    // Estimated cost of evaluating expr, the walk stops once it reaches limit
+    size_t estimateCost(Expression* expr, size_t limit)
+    {
+        size_t cost = 0;
+        forEachNode(expr, [&](Expression* node)
+        {
+            cost += isNumericMethod(node) ? NUMERIC_METHOD_COST : 1;
+            return cost < limit;
+        });
+        return cost;
+    }
+
+    // Evaluates every element into the same position of results. When at least two elements are
+    // expensive the elements are evaluated as tasks on the thread pool. Elements cannot assign or
+    // print, so they only read env while they run
+    void evalElements(const std::vector<Expression*>& elements, Environment& env, std::vector<Expression*>& results)
+    {
+        results.assign(elements.size(), nullptr);
+        size_t expensive = 0;
+        for (size_t i = 0; i < elements.size() && expensive < 2; ++i)
+        {
+            if (dynamic_cast<Number*>(elements[i]) == nullptr && estimateCost(elements[i], PARALLEL_ELEMENT_COST) >= PARALLEL_ELEMENT_COST)
+            {
+                ++expensive;
+            }
+        }
+        if (expensive < 2)
+        {
+            for (size_t i = 0; i < elements.size(); ++i)
+            {
+                results[i] = elements[i]->eval(env);
+            }
+            return;
+        }
+        ThreadPool::instance().parallelFor(elements.size(), [&](size_t i) { results[i] = elements[i]->eval(env); });
+    }
+
+    void destroyAll(std::vector<Expression*>& expressions)
+    {
+        for (auto& exp : expressions)
+        {
+            if (exp != nullptr)
+            {
+                exp->destroy();
+                delete exp;
+                exp = nullptr;
+            }
+        }
+    }
+}
 
 //Unit
 Unit::Unit() {}
@@ -24,6 +128,10 @@ std::string Invalid::toString() const noexcept
 {
     return message.empty() ? "INVALID OPERATION" : "INVALID: " + message;
 }
+const std::string& Invalid::getMessage() const noexcept
+{
+    return message;
+}
 void Invalid::destroy() noexcept {}
 
 //Impossible
@@ -36,6 +144,10 @@ std::string Impossible::toString() const noexcept
 {
     return message.empty() ? "IMPOSSIBLE OPERATION" : "IMPOSSIBLE: " + message;
 }
+const std::string& Impossible::getMessage() const noexcept
+{
+    return message;
+}
 void Impossible::destroy() noexcept {}
 
 // Value
@@ -100,7 +212,13 @@ Expression* Number::eval(Environment& env) const
 }
 std::string Number::toString() const noexcept
 {
-    return std::to_string(number);
+    std::string result;
+    appendNumber(result, number);
+    return result;
+}
+void Number::print(std::string& out) const
+{
+    appendNumber(out, number);
 }
 double Number::getNumber() const
 {
@@ -134,12 +252,14 @@ Expression* Name::eval(Environment& env) const
 {
     if (!env.empty())
     {
-        for (auto pair : env)
+        for (const auto& pair : env)
         {
             if (pair.first == name)
             {
+                // Only a Binding refers to names, and it knows whether one of them is its own
                 Expression* exp = pair.second;
-                if (containsName(exp, name, env))
+                auto binding = dynamic_cast<Binding*>(exp);
+                if (binding != nullptr && binding->isRecursive())
                 {
                     return new Invalid("(Recursive assignment detected for variable '" + name + "')");
                 }
@@ -158,6 +278,158 @@ std::string Name::getName() const noexcept
     return name;
 }
 
+//Binding
+Binding::Binding(Expression* _value, std::vector<std::string> _dependencies, bool _recursive)
+    : value{_value}, dependencies{std::move(_dependencies)}, recursive{_recursive}, version{0}, mutex{}, cached{nullptr} {}
+Expression* Binding::eval(Environment& env) const
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (cached == nullptr)
+    {
+        // Evaluated without the lock, another thread may cache the same value in the meantime
+        uint64_t stamp = version;
+        lock.unlock();
+        Expression* result = value->eval(env);
+        lock.lock();
+        if (cached != nullptr || stamp != version)
+        {
+            return result;
+        }
+        cached = result;
+    }
+    lock.unlock();
+    return cached->eval(env);
+}
+std::string Binding::toString() const noexcept
+{
+    return value->toString();
+}
+void Binding::print(std::string& out) const
+{
+    value->print(out);
+}
+void Binding::destroy() noexcept
+{
+    invalidate();
+    if (value != nullptr)
+    {
+        value->destroy();
+        delete value;
+        value = nullptr;
+    }
+}
+Expression* Binding::getValue() const noexcept
+{
+    return value;
+}
+const std::vector<std::string>& Binding::getDependencies() const noexcept
+{
+    return dependencies;
+}
+bool Binding::isRecursive() const noexcept
+{
+    return recursive;
+}
+uint64_t Binding::getVersion() const noexcept
+{
+    return version;
+}
+void Binding::invalidate() noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ++version;
+    if (cached != nullptr)
+    {
+        cached->destroy();
+        delete cached;
+        cached = nullptr;
+    }
+}
+
+void bindName(Environment& env, const std::string& name, Expression* value)
+{
+    std::vector<std::string> dependencies{};
+    forEachNode(value, [&dependencies](Expression* node)
+    {
+        if (auto dependency = dynamic_cast<Name*>(node))
+        {
+            dependencies.push_back(dependency->getName());
+        }
+        return true;
+    });
+    if (!dependencies.empty())
+    {
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+        bool recursive = std::binary_search(dependencies.begin(), dependencies.end(), name) && containsName(value, name, env);
+        value = new Binding(value, std::move(dependencies), recursive);
+    }
+
+    // Rebinding replaces the old value so long scripts do not grow the environment
+    auto binding = std::find_if(env.begin(), env.end(), [&name](const auto& pair) { return pair.first == name; });
+    if (binding != env.end())
+    {
+        if (binding->second != nullptr)
+        {
+            binding->second->destroy();
+            delete binding->second;
+        }
+        binding->second = value;
+    }
+    else
+    {
+        env.push_front(std::make_pair(name, value));
+    }
+
+    // Only the variables downstream of name lose their cached value
+    std::vector<std::string> changed{name};
+    std::vector<std::string> seen{name};
+    while (!changed.empty())
+    {
+        std::string current = std::move(changed.back());
+        changed.pop_back();
+        for (auto& pair : env)
+        {
+            auto dependent = dynamic_cast<Binding*>(pair.second);
+            if (dependent != nullptr &&
+                std::binary_search(dependent->getDependencies().begin(), dependent->getDependencies().end(), current))
+            {
+                dependent->invalidate();
+                if (std::find(seen.begin(), seen.end(), pair.first) == seen.end())
+                {
+                    seen.push_back(pair.first);
+                    changed.push_back(pair.first);
+                }
+            }
+        }
+    }
+}
+Expression* lookupName(const Environment& env, const std::string& name)
+{
+    auto binding = std::find_if(env.begin(), env.end(), [&name](const auto& pair) { return pair.first == name; });
+    if (binding == env.end())
+    {
+        return nullptr;
+    }
+    auto variable = dynamic_cast<Binding*>(binding->second);
+    return (variable != nullptr) ? variable->getValue() : binding->second;
+}
+
+//String
+String::String(std::string_view _text) : Value(DataType::String), text(_text) {}
+Expression* String::eval(Environment& env) const
+{
+    return new String(text);
+}
+std::string String::toString() const noexcept
+{
+    return text;
+}
+std::string String::getText() const noexcept
+{
+    return text;
+}
+
 // Negation
 Expression* Negation::eval(Environment& env) const
 {
@@ -1135,13 +1407,23 @@ Expression* Pair::eval(Environment& env) const
 }
 std::string Pair::toString() const noexcept
 {
-    return "(" + first->toString() + ", " + second->toString() + ")";
+    std::string result;
+    print(result);
+    return result;
+}
+void Pair::print(std::string& out) const
+{
+    out += "(";
+    first->print(out);
+    out += ", ";
+    second->print(out);
+    out += ")";
 }
-Expression* Pair::getFirst()
+Expression* Pair::getFirst() const
 {
     return first;
 }
-Expression* Pair::getSecond()
+Expression* Pair::getSecond() const
 {
     return second;
 }
@@ -1224,33 +1506,26 @@ Vector::Vector(std::vector<Expression*>& _vectorExpression) : Value(DataType::Ve
 Expression* Vector::eval(Environment& env) const
 {
     std::vector<Expression*> newVector;
-    for (auto exp : vectorExpression)
+    evalElements(vectorExpression, env, newVector);
+    if (std::find(newVector.begin(), newVector.end(), nullptr) != newVector.end())
     {
-        Expression* element = exp->eval(env);
-        if (element == nullptr)
-        {
-            for (auto e : newVector)
-            {
-                e->destroy();
-                delete e;
-            }
-            return new Invalid("One or more elements in the vector could not be evaluated");
-        }
-        newVector.push_back(element);
+        destroyAll(newVector);
+        return new Invalid("One or more elements in the vector could not be evaluated");
     }
     return new Vector(newVector);
 }
 std::string Vector::toString() const noexcept
 {
-    std::string result = "[  ";
-    for (const auto& exp : vectorExpression)
-    {
-        std::string element = exp->toString();
-        result += element +"  ";
-    }
-    result += "]";
+    std::string result;
+    print(result);
     return result;
 }
+void Vector::print(std::string& out) const
+{
+    out += "[  ";
+    forEachShown(vectorExpression.size(), [&](size_t i) { vectorExpression[i]->print(out); out += "  "; }, [&] { out += "...  "; });
+    out += "]";
+}
 std::vector<Expression*> Vector::getVectorExpression() const
 {
     return vectorExpression;
@@ -1270,47 +1545,41 @@ void Vector::destroy() noexcept
 }
 
 //Matrix
-Matrix::Matrix(std::vector<Expression*>& _matrixExpression) : Value(DataType::Matrix), matrixExpression(_matrixExpression) {}
+Matrix::Matrix(std::vector<Expression*>& _matrixExpression) : Value(DataType::Matrix), matrixExpression(_matrixExpression), expanded(), dense(nullptr), rows(0), columns(0) {}
+Matrix::Matrix(std::shared_ptr<const double> _dense, size_t _rows, size_t _columns) : Value(DataType::Matrix), matrixExpression(), expanded(), dense(_dense), rows(_rows), columns(_columns) {}
 Expression* Matrix::eval(Environment& env) const
 {
+    if (isDense())
+    {
+        return new Matrix(dense, rows, columns);
+    }
     std::vector<Expression*> new_matrix{};
     if (!matrixExpression.size())
     {
         return new Invalid("Empty matrix (0x0)");
     }
-    auto first = matrixExpression[0]->eval(env);
-
-    Vector* first_row = dynamic_cast<Vector*>(first);
-    Name* first_row_name = dynamic_cast<Name*>(first);
-
-    if (first_row == nullptr && first_row_name == nullptr)
+    std::vector<Expression*> evaluated{};
+    evalElements(matrixExpression, env, evaluated);
+    auto fail = [&](const std::string& message)
     {
-        first->destroy();
-        delete first;
-        return new Invalid("Matrix arguments must be vectors or names");
-    }
+        destroyAll(evaluated);
+        destroyAll(new_matrix);
+        return new Invalid(message);
+    };
 
     size_t row_size = 0;
 
-    first->destroy();
-    delete first;
-
-    for (Expression* vec : matrixExpression)
+    for (auto& r : evaluated)
     {
-        auto r = vec->eval(env);
         Vector* row = dynamic_cast<Vector*>(r);
         Name* row_name = dynamic_cast<Name*>(r);
         if (row == nullptr && row_name == nullptr)
         {
-            r->destroy();
-            delete r;
-            return new Invalid("Matrix arguments must be vectors or names");
+            return fail("Matrix arguments must be vectors or names");
         }
         if (row_name != nullptr)
         {
             new_matrix.push_back(new Name(row_name->getName()));
-            r->destroy();
-            delete r;
             continue;
         }
         if (row_size == 0)
@@ -1319,15 +1588,7 @@ Expression* Matrix::eval(Environment& env) const
         }
         else if (row->size() != row_size)
         {
-            r->destroy();
-            delete r;
-            for (auto &exp : new_matrix)
-            {
-                exp->destroy();
-                delete exp;
-                exp = nullptr;
-            }
-            return new Invalid("Inconsistent row sizes in matrix");
+            return fail("Inconsistent row sizes in matrix");
         }
         std::vector<Expression*> new_vector{};
         for (Expression* exp : row->getVectorExpression())
@@ -1335,44 +1596,57 @@ Expression* Matrix::eval(Environment& env) const
             Expression* element = exp->eval(env);
             if (element == nullptr)
             {
-                for (auto e : new_vector)
-                {
-                    e->destroy();
-                    delete e;
-                }
-                r->destroy();
-                delete r;
-                for (auto &exp : new_matrix)
-                {
-                    exp->destroy();
-                    delete exp;
-                    exp = nullptr;
-                }
-                return new Invalid("One or more elements in the matrix could not be evaluated");
+                destroyAll(new_vector);
+                return fail("One or more elements in the matrix could not be evaluated");
             }
             new_vector.push_back(element);
         }
-
-        r->destroy();
-        delete r;
-
         new_matrix.push_back(new Vector(new_vector));
     }
+    destroyAll(evaluated);
     return new Matrix(new_matrix);
 }
 std::string Matrix::toString() const noexcept
 {
     std::string result;
-    for (const auto& vec : matrixExpression)
+    print(result);
+    return result;
+}
+void Matrix::print(std::string& out) const
+{
+    if (isDense())
     {
-        std::string element = vec->toString();
-        result += element +" ";
-        result += "\n";
+        const double* data = dense.get();
+        forEachShown(rows, [&](size_t i)
+        {
+            out += "[  ";
+            forEachShown(columns, [&](size_t j) { appendNumber(out, data[i * columns + j]); out += "  "; }, [&] { out += "...  "; });
+            out += "] \n";
+        }, [&] { out += "...\n"; });
+        return;
     }
-    return result;
+    forEachShown(matrixExpression.size(), [&](size_t i) { matrixExpression[i]->print(out); out += " \n"; }, [&] { out += "...\n"; });
 }
 std::vector<Expression*> Matrix::getMatrixExpression() const
 {
+    if (isDense())
+    {
+        std::call_once(expanded, [this]
+        {
+            matrixExpression.reserve(rows);
+            const double* value = dense.get();
+            for (size_t i = 0; i < rows; ++i)
+            {
+                std::vector<Expression*> row{};
+                row.reserve(columns);
+                for (size_t j = 0; j < columns; ++j)
+                {
+                    row.push_back(new Number(*value++));
+                }
+                matrixExpression.push_back(new Vector(row));
+            }
+        });
+    }
     return matrixExpression;
 }
 void Matrix::destroy() noexcept
@@ -1391,6 +1665,10 @@ void Matrix::destroy() noexcept
 
 // Inverse Matrix
 InverseMatrix::InverseMatrix(Expression* _matrix) : Value(DataType::Matrix), matrix(_matrix) {}
+Expression* InverseMatrix::getMatrix() const noexcept
+{
+    return matrix;
+}
 Expression* InverseMatrix::gauss(std::vector<std::vector<Expression*>> matrixExpression) const
 {
     size_t size = matrixExpression.size();
@@ -1502,6 +1780,13 @@ Expression* InverseMatrix::eval(Environment& env) const
         delete evExpr;
         return new Invalid("Expected a Matrix");
     }
+    std::string key{};
+    if (auto cached = MemoCache::instance().find(MemoOperation::Inverse, {evMatrix}, key))
+    {
+        evMatrix->destroy();
+        delete evMatrix;
+        return cached;
+    }
     auto mat = evMatrix->getMatrixExpression();
     std::vector<std::vector<Expression*>> matrix_to_inverse{};
     for (auto &vec : mat)
@@ -1536,6 +1821,7 @@ Expression* InverseMatrix::eval(Environment& env) const
         return new Impossible(text);
     }
     auto result = gauss(matrix_to_inverse);
+    MemoCache::instance().store(std::move(key), *result);
     evMatrix->destroy();
     delete evMatrix;
     return result;
@@ -1556,6 +1842,10 @@ void InverseMatrix::destroy() noexcept
 
 // LU Matrix
 MatrixLU::MatrixLU(Expression* _matrix) : Value(DataType::Matrix), matrix(_matrix) {}
+Expression* MatrixLU::getMatrix() const noexcept
+{
+    return matrix;
+}
 
 Expression* MatrixLU::lowerUpperDecomposition(std::vector<std::vector<Expression*>> matrixExpression) const
 {
@@ -1686,6 +1976,10 @@ void MatrixLU::destroy() noexcept
 }
 
 TridiagonalMatrix::TridiagonalMatrix(Expression* _matrix) : Value(DataType::Matrix), matrix(_matrix) {}
+Expression* TridiagonalMatrix::getMatrix() const noexcept
+{
+    return matrix;
+}
 Expression* TridiagonalMatrix::tridiagonal(std::vector<std::vector<Expression*>> matrix) const
 {
     size_t size = matrix.size();
@@ -1827,6 +2121,10 @@ void TridiagonalMatrix::destroy() noexcept
 
 // Eigenvalues
 RealEigenvalues::RealEigenvalues(Expression* _matrix) : Value(DataType::Matrix), matrix(_matrix) {}
+Expression* RealEigenvalues::getMatrix() const noexcept
+{
+    return matrix;
+}
 void RealEigenvalues::determ(std::vector<double> auxialiaryVector, std::vector<std::vector<double>> answerMatrix, double x, double& middle, size_t l) const
 {
     auxialiaryVector[0] = answerMatrix[0][0] - x;
@@ -1934,6 +2232,13 @@ Expression* RealEigenvalues::eval(Environment& env) const
         delete exp;
         return new Invalid("Expected a Matrix");
     }
+    std::string key{};
+    if (auto cached = MemoCache::instance().find(MemoOperation::RealEigenvalues, {matrixExp}, key))
+    {
+        exp->destroy();
+        delete exp;
+        return cached;
+    }
 
     auto tridiagonalMatrix = TridiagonalMatrix(matrixExp).eval(env);
     auto matTri = dynamic_cast<Matrix*>(tridiagonalMatrix);
@@ -1973,6 +2278,7 @@ Expression* RealEigenvalues::eval(Environment& env) const
         delete r;
     }
     auto result = eigenvalues(toeigen);
+    MemoCache::instance().store(std::move(key), *result);
     for (auto& c : toeigen)
     {
         for(auto& r : c)
@@ -2003,9 +2309,32 @@ void RealEigenvalues::destroy() noexcept
 
 // Determinant
 Determinant::Determinant(Expression* _matrix) : Value(DataType::Number), matrix(_matrix) {}
+Expression* Determinant::getMatrix() const noexcept
+{
+    return matrix;
+}
 Expression* Determinant::eval(Environment& env) const
 {
-    auto matrixPair = new MatrixLU(matrix);
+    auto& memo = MemoCache::instance();
+    // The argument is only evaluated up front when the cache needs its value for the key
+    Expression* evaluated = memo.isEnabled() ? matrix->eval(env) : nullptr;
+    std::string key{};
+    Expression* result = (evaluated != nullptr) ? memo.find(MemoOperation::Determinant, {evaluated}, key) : nullptr;
+    if (result == nullptr)
+    {
+        result = determinant((evaluated != nullptr) ? evaluated : matrix, env);
+        memo.store(std::move(key), *result);
+    }
+    if (evaluated != nullptr)
+    {
+        evaluated->destroy();
+        delete evaluated;
+    }
+    return result;
+}
+Expression* Determinant::determinant(Expression* input, Environment& env) const
+{
+    auto matrixPair = new MatrixLU(input);
     auto second = new PairSecond(matrixPair);
     auto inter = second->eval(env);
     auto upperMatrix = dynamic_cast<Matrix*>(inter);
@@ -2186,8 +2515,20 @@ Expression* Integral::eval(Environment& env) const
         delete va;
         return new Invalid("Integration variable must be a Name");
     }
+    auto evFunction = function->eval(env);
+    std::string key{};
+    Expression* result = MemoCache::instance().find(MemoOperation::Integral, {in, evFunction, va}, key);
     Environment envIntegral = std::forward_list<std::pair<std::string, Expression*>>{};
-    auto result = simpsonMethod(a, b, 100, function->eval(env), envIntegral, var);
+    if (result != nullptr)
+    {
+        evFunction->destroy();
+        delete evFunction;
+    }
+    else
+    {
+        result = simpsonMethod(a, b, 100, evFunction, envIntegral, var);
+        MemoCache::instance().store(std::move(key), *result);
+    }
 
     for (auto& t : envIntegral)
     {
@@ -2240,97 +2581,94 @@ void Integral::destroy() noexcept
     }
 }
 
-// Interpolate
-Interpolate::Interpolate(Expression* _vectorExpression, Expression* _numInter) : vectorExpression(_vectorExpression), numInter(_numInter) {}
-Expression* Interpolate::eval(Environment& env) const
+// Points
+Points::Points(std::shared_ptr<const Columns> _columns) : Value(DataType::Points), columns(_columns) {}
+Expression* Points::eval(Environment& env) const
 {
-    std::vector<double> x;
-    std::vector<double> f;
-    auto ve = vectorExpression->eval(env);
-    auto vector = (dynamic_cast<Vector*>(ve));
-    if (vector == nullptr)
+    return new Points(columns);
+}
+std::string Points::toString() const noexcept
+{
+    std::string result;
+    print(result);
+    return result;
+}
+void Points::print(std::string& out) const
+{
+    out += "[  ";
+    forEachShown(columns->x.size(), [&](size_t i)
+    {
+        out += "(";
+        appendNumber(out, columns->x[i]);
+        out += ", ";
+        appendNumber(out, columns->y[i]);
+        out += ")  ";
+    }, [&] { out += "...  "; });
+    out += "]";
+}
+std::shared_ptr<const Points::Columns> Points::getColumns() const noexcept
+{
+    return columns;
+}
+Expression* Points::fromValue(Expression* value, std::shared_ptr<const Columns>& result)
+{
+    if (auto points = dynamic_cast<Points*>(value))
     {
-        ve->destroy();
-        delete ve;
-        return new Invalid("Expected a Vector");
+        result = points->columns;
+        return nullptr;
     }
-    auto vec = vector->getVectorExpression();
-    int n = vec.size();
-
-    auto nu = numInter->eval(env);
-    auto number = dynamic_cast<Number*>(nu);
-    if (number == nullptr)
+    auto vector = dynamic_cast<Vector*>(value);
+    if (vector == nullptr)
     {
-        nu->destroy();
-        delete nu;
-        ve->destroy();
-        delete ve;
-        return new Invalid("Expected a Number for interpolation");
+        return new Invalid("Expected a Vector of (x, y) pairs or Points");
     }
-    double xa = number->getNumber();
-
+    auto vec = vector->getVectorExpression();
+    auto columns = std::make_shared<Columns>();
+    columns->x.reserve(vec.size());
+    columns->y.reserve(vec.size());
     for (auto exp : vec)
     {
         auto pair = dynamic_cast<Pair*>(exp);
         if (pair == nullptr || pair->getDataType() != DataType::Pair)
         {
-            nu->destroy();
-            delete nu;
-            ve->destroy();
-            delete ve;
-            return new Invalid("Interpolation requires vector of (x, y) pairs");
+            return new Invalid("Expected a Vector of (x, y) pairs");
         }
-        auto num0 = PairFirst{pair}.eval(env);
-        auto num1 = PairSecond{pair}.eval(env);
-        auto num = dynamic_cast<Number*>(num0);
-        auto num2 = dynamic_cast<Number*>(num1);
+        auto num = dynamic_cast<Number*>(pair->getFirst());
+        auto num2 = dynamic_cast<Number*>(pair->getSecond());
         if (num == nullptr || num2 == nullptr)
         {
-            nu->destroy();
-            delete nu;
-            ve->destroy();
-            delete ve;
-            num0->destroy();
-            delete num0;
-            num1->destroy();
-            delete num1;
             return new Invalid("Expected numeric values in the Pair");
         }
-        x.push_back(num->getNumber());
-        f.push_back(num2->getNumber());
-        num0->destroy();
-        delete num0;
-        num1->destroy();
-        delete num1;
-    }
-    double y_res = 0.0;
-    for (int i = 0; i < n; ++i)
-    {
-        double z = 1.0;
-        for (int j = 0; j < n; ++j)
-        {
-            if (i != j)
-            {
-                z = z * (xa - x[j]) / (x[i] - x[j]);
-            }
-        }
-        y_res += z * f[i];
+        columns->x.push_back(num->getNumber());
+        columns->y.push_back(num2->getNumber());
     }
-    nu->destroy();
-    delete nu;
+    result = columns;
+    return nullptr;
+}
+
+CreatePoints::CreatePoints(Expression* _vectorExpression) : vectorExpression(_vectorExpression) {}
+Expression* CreatePoints::eval(Environment& env) const
+{
+    auto ve = vectorExpression->eval(env);
+    std::shared_ptr<const Points::Columns> columns{};
+    auto error = Points::fromValue(ve, columns);
     ve->destroy();
     delete ve;
-    return new Number(y_res);
+    if (error != nullptr)
+    {
+        return error;
+    }
+    return new Points(columns);
 }
-std::string Interpolate::toString() const noexcept
+std::string CreatePoints::toString() const noexcept
 {
-    return vectorExpression->toString() + "\nInterpolate Number: " +numInter->toString();
+    return "Points of: " + vectorExpression->toString();
 }
-std::tuple<Expression*, Expression*> Interpolate::getExpressions() const noexcept
+Expression* CreatePoints::getExpression() const noexcept
 {
-    return std::make_tuple(vectorExpression, numInter);
+    return vectorExpression;
 }
-void Interpolate::destroy() noexcept
+void CreatePoints::destroy() noexcept
 {
     if (vectorExpression != nullptr)
     {
@@ -2338,223 +2676,1811 @@ void Interpolate::destroy() noexcept
         delete vectorExpression;
         vectorExpression = nullptr;
     }
-    if (numInter != nullptr)
-    {
-        numInter->destroy();
-        delete numInter;
-        numInter = nullptr;
-    }
 }
 
-//ODE First
-ODEFirstOrderInitialValues::ODEFirstOrderInitialValues(Expression* _funct, Expression* _initialValue, Expression* _tFinal, Expression* _variable) : funct(_funct), initialValue(_initialValue), tFinal(_tFinal), variable(_variable) {}
-Expression* ODEFirstOrderInitialValues::rungekuttaMethod(double _t, double _x, double f, double h, Expression* function, Environment& env, Name* variable) const
+// Load CSV
+LoadCsv::LoadCsv(Expression* _path, Expression* _layout) : path(_path), layout(_layout) {}
+Expression* LoadCsv::eval(Environment& env) const
 {
-    if (!containsName(function, variable->getName(), env))
-    {
+    auto pa = path->eval(env);
+    auto text = dynamic_cast<String*>(pa);
+    if (text == nullptr)
+    {
+        pa->destroy();
+        delete pa;
+        return new Invalid("Expected a String with the file path");
+    }
+    std::string file{text->getText()};
+    pa->destroy();
+    delete pa;
+
+    bool points = false;
+    if (layout != nullptr)
+    {
+        auto la = layout->eval(env);
+        auto name = dynamic_cast<String*>(la);
+        bool valid = name != nullptr && (name->getText() == "matrix" || name->getText() == "points");
+        points = valid && name->getText() == "points";
+        la->destroy();
+        delete la;
+        if (!valid)
+        {
+            return new Invalid("CSV layout must be \"matrix\" or \"points\"");
+        }
+    }
+
+    auto values = std::make_shared<std::vector<double>>();
+    size_t rows = 0, columns = 0;
+    auto error = readCsv(file, *values, rows, columns);
+    if (error != nullptr)
+    {
+        return error;
+    }
+
+    if (points)
+    {
+        if (columns != 2)
+        {
+            return new Invalid("Points require exactly two columns, got " + std::to_string(columns));
+        }
+        auto data = std::make_shared<Points::Columns>();
+        data->x.reserve(rows);
+        data->y.reserve(rows);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            data->x.push_back((*values)[2 * i]);
+            data->y.push_back((*values)[2 * i + 1]);
+        }
+        return new Points(data);
+    }
+    // The matrix keeps the vector alive through an aliasing pointer to its elements
+    return new Matrix(std::shared_ptr<const double>(values, values->data()), rows, columns);
+}
+std::string LoadCsv::toString() const noexcept
+{
+    return "LOADCSV(" + path->toString() + ")";
+}
+std::tuple<Expression*, Expression*> LoadCsv::getExpressions() const noexcept
+{
+    return std::make_tuple(path, layout);
+}
+void LoadCsv::destroy() noexcept
+{
+    if (path != nullptr)
+    {
+        path->destroy();
+        delete path;
+        path = nullptr;
+    }
+    if (layout != nullptr)
+    {
+        layout->destroy();
+        delete layout;
+        layout = nullptr;
+    }
+}
+
+// Load and Save NPY
+LoadNpy::LoadNpy(Expression* _path) : path(_path) {}
+Expression* LoadNpy::eval(Environment& env) const
+{
+    auto pa = path->eval(env);
+    auto text = dynamic_cast<String*>(pa);
+    if (text == nullptr)
+    {
+        pa->destroy();
+        delete pa;
+        return new Invalid("Expected a String with the file path");
+    }
+    std::string file{text->getText()};
+    pa->destroy();
+    delete pa;
+
+    std::shared_ptr<const double> data{};
+    size_t rows = 0, columns = 0;
+    auto error = mapNpy(file, data, rows, columns);
+    if (error != nullptr)
+    {
+        return error;
+    }
+    return new Matrix(data, rows, columns);
+}
+std::string LoadNpy::toString() const noexcept
+{
+    return "LOADNPY(" + path->toString() + ")";
+}
+Expression* LoadNpy::getExpression() const noexcept
+{
+    return path;
+}
+void LoadNpy::destroy() noexcept
+{
+    if (path != nullptr)
+    {
+        path->destroy();
+        delete path;
+        path = nullptr;
+    }
+}
+
+SaveNpy::SaveNpy(Expression* _path, Expression* _matrix) : path(_path), matrix(_matrix) {}
+Expression* SaveNpy::eval(Environment& env) const
+{
+    auto pa = path->eval(env);
+    auto text = dynamic_cast<String*>(pa);
+    if (text == nullptr)
+    {
+        pa->destroy();
+        delete pa;
+        return new Invalid("Expected a String with the file path");
+    }
+    std::string file{text->getText()};
+    pa->destroy();
+    delete pa;
+
+    auto ma = matrix->eval(env);
+    auto mat = dynamic_cast<Matrix*>(ma);
+    if (mat == nullptr)
+    {
+        ma->destroy();
+        delete ma;
+        return new Invalid("Expected a Matrix");
+    }
+
+    Expression* error = nullptr;
+    if (mat->isDense())
+    {
+        error = writeNpy(file, mat->getData(), mat->size(), mat->getColumns());
+    }
+    else
+    {
+        auto rows = mat->getMatrixExpression();
+        auto first = rows.empty() ? nullptr : dynamic_cast<Vector*>(rows.front());
+        size_t columns = (first != nullptr) ? first->getVectorExpression().size() : 0;
+        std::vector<double> values{};
+        values.reserve(rows.size() * columns);
+        // writeNpy reads rows * columns values, so every row must be a Vector of exactly columns numbers
+        for (auto row : rows)
+        {
+            auto vector = dynamic_cast<Vector*>(row);
+            if (vector == nullptr || columns == 0)
+            {
+                error = new Invalid("Matrix elements must be numeric values");
+                break;
+            }
+            auto elements = vector->getVectorExpression();
+            if (elements.size() != columns)
+            {
+                error = new Invalid("Inconsistent row sizes in matrix");
+                break;
+            }
+            for (auto element : elements)
+            {
+                auto number = dynamic_cast<Number*>(element);
+                if (number == nullptr)
+                {
+                    error = new Invalid("Matrix elements must be numeric values");
+                    break;
+                }
+                values.push_back(number->getNumber());
+            }
+            if (error != nullptr)
+            {
+                break;
+            }
+        }
+        if (error == nullptr && rows.empty())
+        {
+            error = new Invalid("Empty matrix (0x0)");
+        }
+        if (error == nullptr)
+        {
+            error = writeNpy(file, values.data(), rows.size(), columns);
+        }
+    }
+    ma->destroy();
+    delete ma;
+    if (error != nullptr)
+    {
+        return error;
+    }
+    return new Unit();
+}
+std::string SaveNpy::toString() const noexcept
+{
+    return "SAVENPY(" + path->toString() + ", " + matrix->toString() + ")";
+}
+std::tuple<Expression*, Expression*> SaveNpy::getExpressions() const noexcept
+{
+    return std::make_tuple(path, matrix);
+}
+void SaveNpy::destroy() noexcept
+{
+    if (path != nullptr)
+    {
+        path->destroy();
+        delete path;
+        path = nullptr;
+    }
+    if (matrix != nullptr)
+    {
+        matrix->destroy();
+        delete matrix;
+        matrix = nullptr;
+    }
+}
+
+// Interpolate
+Interpolate::Interpolate(Expression* _vectorExpression, Expression* _numInter) : vectorExpression(_vectorExpression), numInter(_numInter) {}
+std::vector<double> Interpolate::barycentricWeights(const std::vector<double>& x)
+{
+    // The products grow like 2^n for close points, so their binary exponents are kept apart and
+    // every weight is scaled by the same power of two, which cancels in barycentricEval
+    size_t n = x.size();
+    std::vector<double> w(n, 1.0);
+    std::vector<int> exponents(n, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            if (i != j)
+            {
+                int exponent = 0;
+                w[i] = std::frexp(w[i] / (x[i] - x[j]), &exponent);
+                exponents[i] += exponent;
+            }
+        }
+    }
+    int largest = (n > 0) ? *std::max_element(exponents.begin(), exponents.end()) : 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        w[i] = std::ldexp(w[i], exponents[i] - largest);
+    }
+    return w;
+}
+double Interpolate::barycentricEval(const std::vector<double>& x, const std::vector<double>& f, const std::vector<double>& w, double xa)
+{
+    double numerator = 0.0;
+    double denominator = 0.0;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        double diff = xa - x[i];
+        if (diff == 0)
+        {
+            return f[i];
+        }
+        double term = w[i] / diff;
+        numerator += term * f[i];
+        denominator += term;
+    }
+    return numerator / denominator;
+}
+bool Interpolate::prepare(const Points::Columns& columns)
+{
+    // Sorting and the O(n^2) weights run once per set of points, each query point then costs O(n)
+    std::call_once(columns.interpolation, [&columns]
+    {
+        std::vector<double> sorted = columns.x;
+        std::sort(sorted.begin(), sorted.end());
+        columns.distinct = std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+        if (columns.distinct)
+        {
+            columns.weights = barycentricWeights(columns.x);
+        }
+    });
+    return columns.distinct;
+}
+Expression* Interpolate::eval(Environment& env) const
+{
+    auto ve = vectorExpression->eval(env);
+    auto nu = numInter->eval(env);
+
+    if (dynamic_cast<Invalid*>(nu) != nullptr || dynamic_cast<Impossible*>(nu) != nullptr)
+    {
+        ve->destroy();
+        delete ve;
+        return nu;
+    }
+    // Stays symbolic while the query depends on an unbound name, like the variable of an INTEGRAL
+    bool unbound = false;
+    forEachNode(nu, [&unbound](Expression* node)
+    {
+        unbound = unbound || dynamic_cast<Name*>(node) != nullptr;
+        return !unbound;
+    });
+    if (unbound)
+    {
+        // Pairs become Points, so every later evaluation shares their weights
+        std::shared_ptr<const Points::Columns> columns{};
+        auto error = (dynamic_cast<Vector*>(ve) != nullptr) ? Points::fromValue(ve, columns) : ve;
+        if (error != nullptr)
+        {
+            if (error != ve)
+            {
+                error->destroy();
+                delete error;
+            }
+            return new Interpolate(ve, nu);
+        }
+        ve->destroy();
+        delete ve;
+        return new Interpolate(new Points(columns), nu);
+    }
+
+    auto number = dynamic_cast<Number*>(nu);
+    auto queries = dynamic_cast<Vector*>(nu);
+    std::vector<double> xa{};
+    if (number != nullptr)
+    {
+        xa.push_back(number->getNumber());
+    }
+    for (auto exp : (queries != nullptr) ? queries->getVectorExpression() : std::vector<Expression*>{})
+    {
+        auto query = dynamic_cast<Number*>(exp);
+        if (query == nullptr)
+        {
+            queries = nullptr;
+            break;
+        }
+        xa.push_back(query->getNumber());
+    }
+    if (number == nullptr && queries == nullptr)
+    {
+        nu->destroy();
+        delete nu;
+        ve->destroy();
+        delete ve;
+        return new Invalid("Expected a Number or a Vector of Numbers for interpolation");
+    }
+    nu->destroy();
+    delete nu;
+
+    if (auto spline = dynamic_cast<Spline*>(ve))
+    {
+        Expression* result = nullptr;
+        if (number != nullptr)
+        {
+            result = new Number(spline->evalAt(xa[0]));
+        }
+        else
+        {
+            std::vector<Expression*> values{};
+            values.reserve(xa.size());
+            for (double point : xa)
+            {
+                values.push_back(new Number(spline->evalAt(point)));
+            }
+            result = new Vector(values);
+        }
+        ve->destroy();
+        delete ve;
+        return result;
+    }
+
+    std::shared_ptr<const Points::Columns> columns{};
+    auto error = Points::fromValue(ve, columns);
+    ve->destroy();
+    delete ve;
+    if (error != nullptr)
+    {
+        return error;
+    }
+    if (!prepare(*columns))
+    {
+        return new Impossible("Interpolation points must have distinct x values");
+    }
+    const auto& x = columns->x;
+    const auto& f = columns->y;
+    const auto& w = columns->weights;
+
+    if (number != nullptr)
+    {
+        return new Number(barycentricEval(x, f, w, xa[0]));
+    }
+    std::vector<Expression*> result{};
+    result.reserve(xa.size());
+    for (double point : xa)
+    {
+        result.push_back(new Number(barycentricEval(x, f, w, point)));
+    }
+    return new Vector(result);
+}
+std::string Interpolate::toString() const noexcept
+{
+    return vectorExpression->toString() + "\nInterpolate Number: " +numInter->toString();
+}
+std::tuple<Expression*, Expression*> Interpolate::getExpressions() const noexcept
+{
+    return std::make_tuple(vectorExpression, numInter);
+}
+void Interpolate::destroy() noexcept
+{
+    if (vectorExpression != nullptr)
+    {
+        vectorExpression->destroy();
+        delete vectorExpression;
+        vectorExpression = nullptr;
+    }
+    if (numInter != nullptr)
+    {
+        numInter->destroy();
+        delete numInter;
+        numInter = nullptr;
+    }
+}
+
+// Spline
+Spline::Spline(std::shared_ptr<const Data> _data) : Value(DataType::Spline), data(_data) {}
+Expression* Spline::eval(Environment& env) const
+{
+    return new Spline(data);
+}
+std::string Spline::toString() const noexcept
+{
+    std::string kind = (data->kind == Kind::Linear) ? "linear" : ((data->kind == Kind::Natural) ? "natural cubic" : "clamped cubic");
+    return "Spline(" + kind + ", " + std::to_string(data->x.size()) + " points)";
+}
+double Spline::evalAt(double xa) const noexcept
+{
+    const auto& x = data->x;
+    size_t segments = x.size() - 1;
+    size_t j = std::upper_bound(x.begin(), x.end(), xa) - x.begin();
+    j = (j == 0) ? 0 : std::min(j - 1, segments - 1);
+    double dx = xa - x[j];
+    return data->a[j] + dx * (data->b[j] + dx * (data->c[j] + dx * data->d[j]));
+}
+
+CreateSpline::CreateSpline(Expression* _vectorExpression, Expression* _kind) : vectorExpression(_vectorExpression), kind(_kind) {}
+Expression* CreateSpline::eval(Environment& env) const
+{
+    auto data = std::make_shared<Spline::Data>();
+    data->kind = Spline::Kind::Natural;
+    double startSlope = 0.0, endSlope = 0.0;
+    if (kind != nullptr)
+    {
+        auto ki = kind->eval(env);
+        auto text = dynamic_cast<String*>(ki);
+        auto slopes = dynamic_cast<Pair*>(ki);
+        auto start = (slopes != nullptr) ? dynamic_cast<Number*>(slopes->getFirst()) : nullptr;
+        auto end = (slopes != nullptr) ? dynamic_cast<Number*>(slopes->getSecond()) : nullptr;
+        bool valid = true;
+        if (text != nullptr && (text->getText() == "linear" || text->getText() == "natural"))
+        {
+            data->kind = (text->getText() == "linear") ? Spline::Kind::Linear : Spline::Kind::Natural;
+        }
+        else if (start != nullptr && end != nullptr)
+        {
+            data->kind = Spline::Kind::Clamped;
+            startSlope = start->getNumber();
+            endSlope = end->getNumber();
+        }
+        else
+        {
+            valid = false;
+        }
+        ki->destroy();
+        delete ki;
+        if (!valid)
+        {
+            return new Invalid("Spline kind must be \"linear\", \"natural\" or a Pair of end slopes");
+        }
+    }
+
+    auto ve = vectorExpression->eval(env);
+    std::shared_ptr<const Points::Columns> columns{};
+    auto error = Points::fromValue(ve, columns);
+    ve->destroy();
+    delete ve;
+    if (error != nullptr)
+    {
+        return error;
+    }
+    std::vector<std::pair<double, double>> points{};
+    points.reserve(columns->x.size());
+    for (size_t i = 0; i < columns->x.size(); ++i)
+    {
+        points.emplace_back(columns->x[i], columns->y[i]);
+    }
+
+    if (points.size() < 2)
+    {
+        return new Invalid("Spline requires at least two points");
+    }
+    if (!std::is_sorted(points.begin(), points.end()))
+    {
+        std::sort(points.begin(), points.end());
+    }
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+        if (points[i].first == points[i - 1].first)
+        {
+            return new Impossible("Interpolation points must have distinct x values");
+        }
+    }
+
+    size_t n = points.size() - 1;
+    auto& x = data->x;
+    auto& a = data->a;
+    x.resize(n + 1);
+    a.resize(n + 1);
+    for (size_t i = 0; i <= n; ++i)
+    {
+        x[i] = points[i].first;
+        a[i] = points[i].second;
+    }
+    std::vector<double> h(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        h[i] = x[i + 1] - x[i];
+    }
+
+    data->b.assign(n, 0.0);
+    data->c.assign(n + 1, 0.0);
+    data->d.assign(n, 0.0);
+    auto& b = data->b;
+    auto& c = data->c;
+    auto& d = data->d;
+
+    if (data->kind == Spline::Kind::Linear)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            b[i] = (a[i + 1] - a[i]) / h[i];
+        }
+        return new Spline(data);
+    }
+
+    // Tridiagonal system for the second order coefficients, solved in O(n)
+    std::vector<double> alpha(n + 1, 0.0), l(n + 1, 1.0), mu(n + 1, 0.0), z(n + 1, 0.0);
+    bool clamped = data->kind == Spline::Kind::Clamped;
+    if (clamped)
+    {
+        alpha[0] = 3 * (a[1] - a[0]) / h[0] - 3 * startSlope;
+        alpha[n] = 3 * endSlope - 3 * (a[n] - a[n - 1]) / h[n - 1];
+        l[0] = 2 * h[0];
+        mu[0] = 0.5;
+        z[0] = alpha[0] / l[0];
+    }
+    for (size_t i = 1; i < n; ++i)
+    {
+        alpha[i] = 3 / h[i] * (a[i + 1] - a[i]) - 3 / h[i - 1] * (a[i] - a[i - 1]);
+        l[i] = 2 * (x[i + 1] - x[i - 1]) - h[i - 1] * mu[i - 1];
+        mu[i] = h[i] / l[i];
+        z[i] = (alpha[i] - h[i - 1] * z[i - 1]) / l[i];
+    }
+    if (clamped)
+    {
+        l[n] = h[n - 1] * (2 - mu[n - 1]);
+        z[n] = (alpha[n] - h[n - 1] * z[n - 1]) / l[n];
+        c[n] = z[n];
+    }
+    for (size_t k = n; k-- > 0;)
+    {
+        c[k] = z[k] - mu[k] * c[k + 1];
+        b[k] = (a[k + 1] - a[k]) / h[k] - h[k] * (c[k + 1] + 2 * c[k]) / 3;
+        d[k] = (c[k + 1] - c[k]) / (3 * h[k]);
+    }
+    return new Spline(data);
+}
+std::string CreateSpline::toString() const noexcept
+{
+    return "Spline of: " + vectorExpression->toString();
+}
+std::tuple<Expression*, Expression*> CreateSpline::getExpressions() const noexcept
+{
+    return std::make_tuple(vectorExpression, kind);
+}
+void CreateSpline::destroy() noexcept
+{
+    if (vectorExpression != nullptr)
+    {
+        vectorExpression->destroy();
+        delete vectorExpression;
+        vectorExpression = nullptr;
+    }
+    if (kind != nullptr)
+    {
+        kind->destroy();
+        delete kind;
+        kind = nullptr;
+    }
+}
+
+//ODE First
+ODEFirstOrderInitialValues::ODEFirstOrderInitialValues(Expression* _funct, Expression* _initialValue, Expression* _tFinal, Expression* _variable, Expression* _output) : funct(_funct), initialValue(_initialValue), tFinal(_tFinal), variable(_variable), output(_output) {}
+Expression* ODEFirstOrderInitialValues::openTrajectory(Environment& env, const std::vector<std::string>& columns, std::unique_ptr<TrajectoryWriter>& writer) const
+{
+    if (output == nullptr)
+    {
+        return nullptr;
+    }
+    auto out = output->eval(env);
+    auto path = dynamic_cast<String*>(out);
+    if (path == nullptr)
+    {
+        out->destroy();
+        delete out;
+        return new Invalid("ODE trajectory output must be a String path");
+    }
+    std::string file = path->getText();
+    out->destroy();
+    delete out;
+    writer = std::make_unique<TrajectoryWriter>(file, columns);
+    if (!writer->isOpen())
+    {
+        writer.reset();
+        return new Impossible("Cannot open trajectory file '" + file + "'");
+    }
+    return nullptr;
+}
+Expression* ODEFirstOrderInitialValues::closeTrajectory(std::unique_ptr<TrajectoryWriter>& writer, Expression* result)
+{
+    if (writer && !writer->close())
+    {
+        std::string file = writer->getPath();
+        result->destroy();
+        delete result;
+        return new Impossible("Could not write trajectory file '" + file + "'");
+    }
+    return result;
+}
+Expression* ODEFirstOrderInitialValues::rungekuttaMethod(double _t, double _x, double f, double h, Expression* function, Environment& env, Name* variable, const StepObserver& onStep) const
+{
+    if (!containsName(function, variable->getName(), env))
+    {
         std::string text = "Expected variable '" + variable->getName() + "' in function " + function->toString();
         function->destroy();
         delete function;
-        return new Invalid(text);
+        return new Invalid(text);
+    }
+
+    env.push_front(std::make_pair(variable->getName(), new Number(_x)));
+    auto& slot = env.front();
+    auto bind = [&slot](double value)
+    {
+        slot.second->destroy();
+        delete slot.second;
+        slot.second = new Number(value);
+    };
+
+    double t = _t, x = _x, tn = f;
+    if (onStep)
+    {
+        onStep(t, &x, 1);
+    }
+    while(t < tn)
+    {
+        bind(x);
+        auto ev_func1 = function->eval(env);
+        auto num1 = dynamic_cast<Number*>(ev_func1);
+
+        if (num1 == nullptr)
+        {
+            function->destroy();
+            delete function;
+            ev_func1->destroy();
+            delete ev_func1;
+            return new Invalid("Expected that elements in the function evaluate to numeric values");
+        }
+        double k1 = h * num1->getNumber();
+
+        bind(x + 0.5 * k1);
+        auto ev_func2 = function->eval(env);
+        auto num2 = dynamic_cast<Number*>(ev_func2);
+
+        if(num2 == nullptr)
+        {
+            function->destroy();
+            delete function;
+            ev_func1->destroy();
+            delete ev_func1;
+            ev_func2->destroy();
+            delete ev_func2;
+            return new Invalid("Expected that elements in the function evaluate to numeric values");
+        }
+
+        double k2 = h * num2->getNumber();
+
+        bind(x + 0.5 * k2);
+        auto ev_func3 = function->eval(env);
+        auto num3 = dynamic_cast<Number*>(ev_func3);
+
+        if (num3 == nullptr)
+        {
+            function->destroy();
+            delete function;
+            ev_func1->destroy();
+            delete ev_func1;
+            ev_func2->destroy();
+            delete ev_func2;
+            ev_func3->destroy();
+            return new Invalid("Expected that elements in the function evaluate to numeric values");
+        }
+        double k3 = h * num3->getNumber();
+
+        bind(x + k3);
+        auto ev_func4 = function->eval(env);
+        auto num4 = dynamic_cast<Number*>(ev_func4);
+
+        if (num4 == nullptr)
+        {
+            function->destroy();
+            delete function;
+            ev_func1->destroy();
+            delete ev_func1;
+            ev_func2->destroy();
+            delete ev_func2;
+            ev_func3->destroy();
+            delete ev_func3;
+            ev_func4->destroy();
+            delete ev_func4;
+            return new Invalid("Expected that elements in the function evaluate to numeric values");
+        }
+        double k4 = h * num4->getNumber();
+
+        x = x + (1.0/6.0)*(k1 + 2*k2 + 2*k3 + k4);
+        t = t + h;
+        if (onStep)
+        {
+            onStep(t, &x, 1);
+        }
+
+        ev_func1->destroy();
+        delete ev_func1;
+        ev_func2->destroy();
+        delete ev_func2;
+        ev_func3->destroy();
+        delete ev_func3;
+        ev_func4->destroy();
+        delete ev_func4;
+    }
+    function->destroy();
+    delete function;
+    return new Pair(new Number(t), new Number(x));
+}
+Expression* ODEFirstOrderInitialValues::rungekuttaSystemMethod(double _t, std::vector<double> x, double f, double h, Vector* functions, Environment& env, Vector* variables, const StepObserver& onStep) const
+{
+    auto equations = functions->getVectorExpression();
+    auto names = variables->getVectorExpression();
+    size_t n = x.size();
+
+    std::vector<std::pair<std::string, Expression*>*> state{};
+    for (auto exp : names)
+    {
+        auto name = dynamic_cast<Name*>(exp);
+        if (name == nullptr)
+        {
+            return new Invalid("ODE variable must be a Name");
+        }
+        env.push_front(std::make_pair(name->getName(), new Number(0.0)));
+        state.push_back(&env.front());
+    }
+
+    // k1..k4 are stored one after another so every stage works on contiguous memory
+    std::vector<double> k(4 * n), y(n);
+    auto derivatives = [&](const std::vector<double>& point, double* out) -> Expression*
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            state[i]->second->destroy();
+            delete state[i]->second;
+            state[i]->second = new Number(point[i]);
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto ev = equations[i]->eval(env);
+            auto num = dynamic_cast<Number*>(ev);
+            if (num == nullptr)
+            {
+                ev->destroy();
+                delete ev;
+                return new Invalid("Expected that elements in the function evaluate to numeric values");
+            }
+            out[i] = h * num->getNumber();
+            ev->destroy();
+            delete ev;
+        }
+        return nullptr;
+    };
+
+    double t = _t, tn = f;
+    if (onStep)
+    {
+        onStep(t, x.data(), n);
+    }
+    while (t < tn)
+    {
+        double* k1 = k.data();
+        double* k2 = k1 + n;
+        double* k3 = k2 + n;
+        double* k4 = k3 + n;
+
+        Expression* error = derivatives(x, k1);
+        for (size_t i = 0; error == nullptr && i < n; ++i)
+        {
+            y[i] = x[i] + 0.5 * k1[i];
+        }
+        error = (error == nullptr) ? derivatives(y, k2) : error;
+        for (size_t i = 0; error == nullptr && i < n; ++i)
+        {
+            y[i] = x[i] + 0.5 * k2[i];
+        }
+        error = (error == nullptr) ? derivatives(y, k3) : error;
+        for (size_t i = 0; error == nullptr && i < n; ++i)
+        {
+            y[i] = x[i] + k3[i];
+        }
+        error = (error == nullptr) ? derivatives(y, k4) : error;
+        if (error != nullptr)
+        {
+            return error;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            x[i] = x[i] + (1.0/6.0)*(k1[i] + 2*k2[i] + 2*k3[i] + k4[i]);
+        }
+        t = t + h;
+        if (onStep)
+        {
+            onStep(t, x.data(), n);
+        }
+    }
+
+    std::vector<Expression*> newVector{};
+    for (size_t i = 0; i < n; ++i)
+    {
+        newVector.push_back(new Number(x[i]));
+    }
+    return new Pair(new Number(t), new Vector(newVector));
+}
+Expression* ODEFirstOrderInitialValues::rungekuttaEnsembleMethod(std::vector<double> t, std::vector<double> x, double f, double h, Expression* function, Name* variable) const
+{
+    size_t count = x.size();
+    auto& pool = ThreadPool::instance();
+    size_t blockSize = std::max<size_t>(1, (count + pool.size() - 1) / pool.size());
+    size_t blocks = (count + blockSize - 1) / blockSize;
+    std::vector<Expression*> errors(blocks, nullptr);
+
+    pool.parallelFor(blocks, [&](size_t block)
+    {
+        size_t begin = block * blockSize;
+        size_t end = std::min(count, begin + blockSize);
+
+        Environment envOde = std::forward_list<std::pair<std::string, Expression*>>{};
+        envOde.push_front(std::make_pair(variable->getName(), new Number(0.0)));
+        auto& slot = envOde.front();
+        auto slope = [&](double value, double& out)
+        {
+            slot.second->destroy();
+            delete slot.second;
+            slot.second = new Number(value);
+            auto ev = function->eval(envOde);
+            auto num = dynamic_cast<Number*>(ev);
+            bool ok = num != nullptr;
+            if (ok)
+            {
+                out = h * num->getNumber();
+            }
+            ev->destroy();
+            delete ev;
+            return ok;
+        };
+
+        // The trajectories of a block advance together, one RK4 stage at a time over
+        // structure of arrays storage, until every one of them reaches t_final
+        std::vector<size_t> active{};
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (t[i] < f)
+            {
+                active.push_back(i);
+            }
+        }
+        size_t n = active.size();
+        std::vector<double> k1(n), k2(n), k3(n), k4(n);
+        bool ok = true;
+        while (ok && !active.empty())
+        {
+            n = active.size();
+            for (size_t j = 0; ok && j < n; ++j)
+            {
+                ok = slope(x[active[j]], k1[j]);
+            }
+            for (size_t j = 0; ok && j < n; ++j)
+            {
+                ok = slope(x[active[j]] + 0.5 * k1[j], k2[j]);
+            }
+            for (size_t j = 0; ok && j < n; ++j)
+            {
+                ok = slope(x[active[j]] + 0.5 * k2[j], k3[j]);
+            }
+            for (size_t j = 0; ok && j < n; ++j)
+            {
+                ok = slope(x[active[j]] + k3[j], k4[j]);
+            }
+            if (!ok)
+            {
+                break;
+            }
+
+            size_t stillActive = 0;
+            for (size_t j = 0; j < n; ++j)
+            {
+                size_t i = active[j];
+                x[i] = x[i] + (1.0/6.0)*(k1[j] + 2*k2[j] + 2*k3[j] + k4[j]);
+                t[i] = t[i] + h;
+                if (t[i] < f)
+                {
+                    active[stillActive++] = i;
+                }
+            }
+            active.resize(stillActive);
+        }
+        if (!ok)
+        {
+            errors[block] = new Invalid("Expected that elements in the function evaluate to numeric values");
+        }
+
+        for (auto& b : envOde)
+        {
+            b.second->destroy();
+            delete b.second;
+            b.second = nullptr;
+        }
+    });
+
+    Expression* error = nullptr;
+    for (auto e : errors)
+    {
+        if (e != nullptr && error == nullptr)
+        {
+            error = e;
+        }
+        else if (e != nullptr)
+        {
+            e->destroy();
+            delete e;
+        }
+    }
+    if (error != nullptr)
+    {
+        return error;
+    }
+
+    std::vector<Expression*> finalStates{};
+    for (size_t i = 0; i < count; ++i)
+    {
+        finalStates.push_back(new Pair(new Number(t[i]), new Number(x[i])));
+    }
+    return new Vector(finalStates);
+}
+Expression* ODEFirstOrderInitialValues::eval(Environment& env) const
+{
+    auto ini = initialValue->eval(env);
+    auto initialV = dynamic_cast<Pair*>(ini);
+
+    auto initialVector = dynamic_cast<Vector*>(ini);
+    if (initialVector != nullptr)
+    {
+        Expression* result = nullptr;
+        std::vector<double> ts{};
+        std::vector<double> xs{};
+        for (auto exp : initialVector->getVectorExpression())
+        {
+            auto pair = dynamic_cast<Pair*>(exp);
+            auto t0 = (pair != nullptr) ? dynamic_cast<Number*>(pair->getFirst()) : nullptr;
+            auto x0 = (pair != nullptr) ? dynamic_cast<Number*>(pair->getSecond()) : nullptr;
+            if (t0 == nullptr || x0 == nullptr)
+            {
+                result = new Invalid("ODE ensemble requires a Vector of numeric (t0, x0) pairs");
+                break;
+            }
+            ts.push_back(t0->getNumber());
+            xs.push_back(x0->getNumber());
+        }
+
+        auto tE = tFinal->eval(env);
+        auto tEval = dynamic_cast<Number*>(tE);
+        auto va = variable->eval(env);
+        auto var = dynamic_cast<Name*>(va);
+        auto fu = funct->eval(env);
+
+        if (result == nullptr && tEval == nullptr)
+        {
+            result = new Invalid("Invalid arguments received");
+        }
+        else if (result == nullptr && var == nullptr)
+        {
+            result = new Invalid("ODE variable must be a Name");
+        }
+        else if (result == nullptr && output != nullptr)
+        {
+            result = new Invalid("ODE trajectory output is not available for ensembles");
+        }
+        else if (result == nullptr && !containsName(fu, var->getName(), env))
+        {
+            result = new Invalid("Expected variable '" + var->getName() + "' in function " + fu->toString());
+        }
+        for (size_t i = 0; result == nullptr && i < ts.size(); ++i)
+        {
+            if (tEval->getNumber() < ts[i])
+            {
+                result = new Impossible("Time interval must be ordered as [t_init, t_final] where t_final > t_init");
+            }
+        }
+
+        if (result == nullptr)
+        {
+            result = rungekuttaEnsembleMethod(ts, xs, tEval->getNumber(), 0.1, fu, var);
+        }
+
+        ini->destroy();
+        delete ini;
+        tE->destroy();
+        delete tE;
+        va->destroy();
+        delete va;
+        fu->destroy();
+        delete fu;
+        return result;
+    }
+
+    auto t0 = PairFirst{initialValue}.eval(env);
+    auto to = dynamic_cast<Number*>(t0);
+
+    auto x0 = PairSecond{initialValue}.eval(env);
+    auto xo = dynamic_cast<Number*>(x0);
+
+    auto tE = tFinal->eval(env);
+    auto tEval = dynamic_cast<Number*>(tE);
+
+    auto xoVector = dynamic_cast<Vector*>(x0);
+    if (initialV != nullptr && to != nullptr && xoVector != nullptr && tEval != nullptr)
+    {
+        Expression* result = nullptr;
+        std::vector<double> x{};
+        for (auto exp : xoVector->getVectorExpression())
+        {
+            auto num = dynamic_cast<Number*>(exp);
+            if (num == nullptr)
+            {
+                result = new Invalid("Expected numeric values in the initial state Vector");
+                break;
+            }
+            x.push_back(num->getNumber());
+        }
+
+        auto fu = funct->eval(env);
+        auto functions = dynamic_cast<Vector*>(fu);
+        auto va = variable->eval(env);
+        auto variables = dynamic_cast<Vector*>(va);
+
+        if (result == nullptr && (functions == nullptr || variables == nullptr))
+        {
+            result = new Invalid("ODE system requires a Vector of functions and a Vector of variables");
+        }
+        else if (result == nullptr && (functions->size() != x.size() || variables->size() != x.size()))
+        {
+            result = new Invalid("ODE system requires the same number of functions, variables and initial values");
+        }
+        else if (result == nullptr && tEval->getNumber() < to->getNumber())
+        {
+            result = new Impossible("Time interval must be ordered as [t_init, t_final] where t_final > t_init");
+        }
+
+        std::unique_ptr<TrajectoryWriter> writer{};
+        if (result == nullptr)
+        {
+            std::vector<std::string> columns{"t"};
+            for (auto exp : variables->getVectorExpression())
+            {
+                columns.push_back(exp->toString());
+            }
+            result = openTrajectory(env, columns, writer);
+        }
+
+        if (result == nullptr)
+        {
+            StepObserver onStep = nullptr;
+            if (writer)
+            {
+                onStep = [&writer](double t, const double* state, size_t n) { writer->write(t, state, n); };
+            }
+            Environment envOde = std::forward_list<std::pair<std::string, Expression*>>{};
+            result = closeTrajectory(writer, rungekuttaSystemMethod(to->getNumber(), x, tEval->getNumber(), 0.1, functions, envOde, variables, onStep));
+            for (auto& t : envOde)
+            {
+                if (t.second != nullptr)
+                {
+                    t.second->destroy();
+                    delete t.second;
+                    t.second = nullptr;
+                }
+            }
+        }
+
+        ini->destroy();
+        delete ini;
+        t0->destroy();
+        delete t0;
+        x0->destroy();
+        delete x0;
+        tE->destroy();
+        delete tE;
+        fu->destroy();
+        delete fu;
+        va->destroy();
+        delete va;
+        return result;
+    }
+
+    if (initialV == nullptr || to == nullptr || xo == nullptr || tEval == nullptr)
+    {
+        ini->destroy();
+        delete ini;
+        t0->destroy();
+        delete t0;
+        x0->destroy();
+        delete x0;
+        tE->destroy();
+        delete tE;
+        return new Invalid("Invalid arguments received");
+    }
+    double t = to->getNumber();
+    double x = xo->getNumber();
+    double f = tEval->getNumber();
+    double step = 0.1;
+    if (f < t)
+    {
+        ini->destroy();
+        delete ini;
+        t0->destroy();
+        delete t0;
+        x0->destroy();
+        delete x0;
+        tE->destroy();
+        delete tE;
+        return new Impossible("Time interval must be ordered as [t_init, t_final] where t_final > t_init");
+    }
+    auto va = variable->eval(env);
+    auto var = dynamic_cast<Name*>(va);
+    if (var == nullptr)
+    {
+        ini->destroy();
+        delete ini;
+        t0->destroy();
+        delete t0;
+        x0->destroy();
+        delete x0;
+        tE->destroy();
+        delete tE;
+        va->destroy();
+        delete va;
+        return new Invalid("ODE variable must be a Name");
+    }
+
+    std::unique_ptr<TrajectoryWriter> writer{};
+    auto error = openTrajectory(env, {"t", var->getName()}, writer);
+    if (error != nullptr)
+    {
+        ini->destroy();
+        delete ini;
+        t0->destroy();
+        delete t0;
+        x0->destroy();
+        delete x0;
+        tE->destroy();
+        delete tE;
+        va->destroy();
+        delete va;
+        return error;
+    }
+    StepObserver onStep = nullptr;
+    if (writer)
+    {
+        onStep = [&writer](double t, const double* state, size_t n) { writer->write(t, state, n); };
+    }
+
+    Environment envOde = std::forward_list<std::pair<std::string, Expression*>>{};
+
+    auto result = closeTrajectory(writer, rungekuttaMethod(t, x, f, step, funct->eval(env), envOde, var, onStep));
+
+    for (auto& t : envOde)
+    {
+        if (t.second != nullptr)
+        {
+            t.second->destroy();
+            delete t.second;
+            t.second = nullptr;
+        }
+    }
+    ini->destroy();
+    delete ini;
+    t0->destroy();
+    delete t0;
+    x0->destroy();
+    delete x0;
+    tE->destroy();
+    delete tE;
+    va->destroy();
+    delete va;
+    return result;
+}
+std::string ODEFirstOrderInitialValues::toString() const noexcept
+{
+    return variable->toString() + "' = " + funct->toString() +"\n[t,"+ variable->toString()+"] = " + initialValue->toString() + "\nT_Final: " + tFinal->toString() + ((output != nullptr) ? "\nTrajectory: " + output->toString() : "");
+}
+std::tuple<Expression*, Expression*, Expression*, Expression*> ODEFirstOrderInitialValues::getExpressions() const noexcept
+{
+    return std::make_tuple(funct, initialValue, tFinal, variable);
+}
+Expression* ODEFirstOrderInitialValues::getOutput() const noexcept
+{
+    return output;
+}
+void ODEFirstOrderInitialValues::destroy() noexcept
+{
+    if (funct != nullptr)
+    {
+        funct->destroy();
+        delete funct;
+        funct = nullptr;
+    }
+    if (initialValue != nullptr)
+    {
+        initialValue->destroy();
+        delete initialValue;
+        initialValue = nullptr;
+    }
+    if (tFinal != nullptr)
+    {
+        tFinal->destroy();
+        delete tFinal;
+        tFinal = nullptr;
+    }
+    if (variable != nullptr)
+    {
+        variable->destroy();
+        delete variable;
+        variable = nullptr;
+    }
+    if (output != nullptr)
+    {
+        output->destroy();
+        delete output;
+        output = nullptr;
+    }
+}
+
+FindRootBisection::FindRootBisection(Expression* _interval, Expression* _function, Expression* _variable, Expression* _iterationLimit) : interval(_interval), function(_function), variable(_variable), iterationLimit(_iterationLimit) {}
+Expression* FindRootBisection::bisectionMethod(Number* left, Number* right, Expression* evFunction, Environment& env, Name* _variable, Number* _iterationLimit) const
+{
+    if (!left || !right || !evFunction || !_variable || !_iterationLimit)
+    {
+        evFunction->destroy();
+        delete evFunction;
+        return new Invalid("Invalid arguments received");
+    }
+    if (!containsName(evFunction, _variable->getName(), env))
+    {
+        std::string text = "Expected variable '" + _variable->getName() + "' in function " + function->toString();
+        evFunction->destroy();
+        delete evFunction;
+        return new Invalid(text);
+    }
+
+    double a = left->getNumber(), c = right->getNumber(), ep = 0.000001;
+    size_t il = _iterationLimit->getNumber();
+
+    std::string var = _variable->getName();
+
+    env.push_front(std::make_pair(var, left));
+    auto inter = evFunction->eval(env);
+    auto _ya = dynamic_cast<Number*>(inter);
+
+    env.push_front(std::make_pair(var, right));
+
+    if (_ya == nullptr)
+    {
+        evFunction->destroy();
+        delete evFunction;
+        inter->destroy();
+        delete inter;
+        return new Invalid("Expected that elements in the function evaluate to numeric values");
+    }
+    double ya = _ya->getNumber();
+
+    auto inter2 = evFunction->eval(env);
+    auto _yc = dynamic_cast<Number*>(inter2);
+    if (_yc == nullptr)
+    {
+        evFunction->destroy();
+        delete evFunction;
+        inter->destroy();
+        delete inter;
+        inter2->destroy();
+        delete inter2;
+        return new Invalid("Expected that elements in the function evaluate to numeric values");
+    }
+    double yc_ = _yc->getNumber();
+
+    int it = 0;
+
+    while (++it <= il)
+    {
+        double b = (a + c) / 2;
+        env.push_front(std::make_pair(var, new Number(b)));
+        auto yb_ = evFunction->eval(env);
+        auto _yb = dynamic_cast<Number*>(yb_);
+        if (_yb == nullptr)
+        {
+            yb_->destroy();
+            delete yb_;
+            break;
+        }
+        double yb = _yb->getNumber();
+        if (std::abs(b - a) < ep)
+        {
+            yb_->destroy();
+            delete yb_;
+            break;
+        }
+        if (ya * yb <= 0)
+        {
+            c = b;
+            yc_ = yb;
+        }
+        else
+        {
+            a = b;
+            ya = yb;
+        }
+        yb_->destroy();
+        delete yb_;
+    }
+    evFunction->destroy();
+    delete evFunction;
+    inter->destroy();
+    delete inter;
+    inter2->destroy();
+    delete inter2;
+    return new Number((a + c) / 2);
+}
+Expression* FindRootBisection::eval(Environment& env) const
+{
+    auto evIn = interval->eval(env);
+    auto evInterval = dynamic_cast<Pair*>(evIn);
+
+    if (evInterval == nullptr)
+    {
+        auto pair = dynamic_cast<Value*>(evIn);
+        if (pair != nullptr)
+        {
+            std::string text = "Expected Pair, got "+ dataTypeToString(pair->getDataType());
+            evIn->destroy();
+            delete evIn;
+            return new Invalid(text);
+        }
+        evIn->destroy();
+        delete evIn;
+        return new Invalid("Expected Pair, got different type");
+    }
+    auto l = PairFirst{evInterval}.eval(env);
+    auto left = dynamic_cast<Number*>(l);
+    auto r = PairSecond{evInterval}.eval(env);
+    auto right = dynamic_cast<Number*>(r);
+
+    if (left == nullptr || right == nullptr)
+    {
+        evIn->destroy();
+        delete evIn;
+        l->destroy();
+        delete l;
+        r->destroy();
+        delete r;
+        return new Invalid("Expected numeric values in the interval");
+    }
+
+    if (left->getNumber() > right->getNumber())
+    {
+        evIn->destroy();
+        delete evIn;
+        l->destroy();
+        delete l;
+        r->destroy();
+        delete r;
+        return new Invalid("Interval must be ordered as [init, final] where final > init");
+    }
+    auto v = variable->eval(env);
+    auto var = dynamic_cast<Name*>(v);
+
+    if (var == nullptr)
+    {
+        evIn->destroy();
+        delete evIn;
+        l->destroy();
+        delete l;
+        r->destroy();
+        delete r;
+        v->destroy();
+        delete v;
+        return new Invalid("Variable must be a Name");
+    }
+
+    auto ite = iterationLimit->eval(env);
+    auto it = dynamic_cast<Number*>(ite);
+
+    if (it == nullptr)
+    {
+        evIn->destroy();
+        delete evIn;
+        l->destroy();
+        delete l;
+        r->destroy();
+        delete r;
+        v->destroy();
+        delete v;
+        ite->destroy();
+        delete ite;
+        return new Invalid("Iteration limit must be a Number");
+    }
+
+    Environment envBi = std::forward_list<std::pair<std::string, Expression*>>{};
+    auto result = bisectionMethod(left, right, function->eval(env), envBi, var, it);
+    for (auto& t : envBi)
+    {
+        if (t.second != nullptr)
+        {
+            t.second->destroy();
+            delete t.second;
+            t.second = nullptr;
+        }
+    }
+
+    evIn->destroy();
+    delete evIn;
+    v->destroy();
+    delete v;
+    ite->destroy();
+    delete ite;
+    return result;
+}
+std::string FindRootBisection::toString() const noexcept
+{
+    return "Interval: " + interval->toString() + " | Function: " + function->toString();
+}
+std::tuple<Expression*, Expression*, Expression*, Expression*> FindRootBisection::getExpressions() const noexcept
+{
+    return std::make_tuple(interval, function, variable, iterationLimit);
+}
+void FindRootBisection::destroy() noexcept
+{
+    if (interval != nullptr)
+    {
+        interval->destroy();
+        delete interval;
+        interval = nullptr;
+    }
+    if (function != nullptr)
+    {
+        function->destroy();
+        delete function;
+        function = nullptr;
+    }
+    if (variable != nullptr)
+    {
+        variable->destroy();
+        delete variable;
+        variable = nullptr;
+    }
+    if (iterationLimit != nullptr)
+    {
+        iterationLimit->destroy();
+        delete iterationLimit;
+        iterationLimit = nullptr;
+    }
+}
+
+FindRoot::FindRoot(Expression* _interval, Expression* _function, Expression* _variable, Expression* _method, Expression* _tolerance) : interval(_interval), function(_function), variable(_variable), method(_method), tolerance(_tolerance) {}
+Expression* FindRoot::brentMethod(double a, double b, double tolerance, PointEvaluator& f, double& root)
+{
+    double fa = 0.0, fb = 0.0;
+    if (auto error = f(a, fa))
+    {
+        return error;
+    }
+    if (auto error = f(b, fb))
+    {
+        return error;
+    }
+    if (fa * fb > 0)
+    {
+        return new Impossible("Function must change sign over the interval");
+    }
+    if (fa == 0)
+    {
+        root = a;
+        return nullptr;
+    }
+
+    double c = a, fc = fa, d = b - a, e = d;
+    for (int it = 0; it < 100; ++it)
+    {
+        if (fb * fc > 0)
+        {
+            c = a;
+            fc = fa;
+            d = b - a;
+            e = d;
+        }
+        if (std::abs(fc) < std::abs(fb))
+        {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+        double tol = 2 * std::numeric_limits<double>::epsilon() * std::abs(b) + 0.5 * tolerance;
+        double m = 0.5 * (c - b);
+        if (std::abs(m) <= tol || fb == 0)
+        {
+            break;
+        }
+        if (std::abs(e) >= tol && std::abs(fa) > std::abs(fb))
+        {
+            // Inverse quadratic interpolation, or secant when only two points are distinct
+            double s = fb / fa, p, q;
+            if (a == c)
+            {
+                p = 2 * m * s;
+                q = 1 - s;
+            }
+            else
+            {
+                double r = fb / fc;
+                q = fa / fc;
+                p = s * (2 * m * q * (q - r) - (b - a) * (r - 1));
+                q = (q - 1) * (r - 1) * (s - 1);
+            }
+            if (p > 0)
+            {
+                q = -q;
+            }
+            else
+            {
+                p = -p;
+            }
+            if (2 * p < std::min(3 * m * q - std::abs(tol * q), std::abs(e * q)))
+            {
+                e = d;
+                d = p / q;
+            }
+            else
+            {
+                d = m;
+                e = m;
+            }
+        }
+        else
+        {
+            d = m;
+            e = m;
+        }
+        a = b;
+        fa = fb;
+        b += (std::abs(d) > tol) ? d : ((m > 0) ? tol : -tol);
+        if (auto error = f(b, fb))
+        {
+            return error;
+        }
+    }
+    root = b;
+    return nullptr;
+}
+Expression* FindRoot::newtonMethod(double left, double right, double tolerance, Expression* evFunction, const std::string& var, double& root) const
+{
+    double x = (left + right) / 2;
+    for (int it = 0; it < 100; ++it)
+    {
+        Dual dual{};
+        if (auto error = evalDual(evFunction, var, x, dual))
+        {
+            return error;
+        }
+        if (dual.value == 0)
+        {
+            root = x;
+            return nullptr;
+        }
+        if (dual.derivative == 0)
+        {
+            return new Impossible("Newton method reached a zero derivative");
+        }
+        double dx = dual.value / dual.derivative;
+        x -= dx;
+        if (x < left || x > right)
+        {
+            return new Impossible("Newton method left the interval");
+        }
+        if (std::abs(dx) < tolerance)
+        {
+            root = x;
+            return nullptr;
+        }
+    }
+    return new Impossible("Newton method did not converge");
+}
+Expression* FindRoot::secantMethod(double x0, double x1, double tolerance, PointEvaluator& f, double& root) const
+{
+    double f0 = 0.0, f1 = 0.0;
+    if (auto error = f(x0, f0))
+    {
+        return error;
     }
-
-    double t = _t, x = _x, tn = f;
-    while(t < tn)
+    if (auto error = f(x1, f1))
     {
-        env.push_front(std::make_pair(variable->getName(), new Number(x)));
-        auto ev_func1 = function->eval(env);
-        auto num1 = dynamic_cast<Number*>(ev_func1);
-
-        if (num1 == nullptr)
+        return error;
+    }
+    for (int it = 0; it < 100; ++it)
+    {
+        if (f1 == 0)
         {
-            function->destroy();
-            delete function;
-            ev_func1->destroy();
-            delete ev_func1;
-            return new Invalid("Expected that elements in the function evaluate to numeric values");
+            root = x1;
+            return nullptr;
         }
-        double k1 = h * num1->getNumber();
-
-        env.push_front(std::make_pair(variable->getName(), new Number(x + 0.5 * k1)));
-        auto ev_func2 = function->eval(env);
-        auto num2 = dynamic_cast<Number*>(ev_func2);
-
-        if(num2 == nullptr)
+        if (f1 == f0)
         {
-            function->destroy();
-            delete function;
-            ev_func1->destroy();
-            delete ev_func1;
-            ev_func2->destroy();
-            delete ev_func2;
-            return new Invalid("Expected that elements in the function evaluate to numeric values");
+            return new Impossible("Secant method reached a flat segment");
         }
-
-        double k2 = h * num2->getNumber();
-
-        env.push_front(std::make_pair(variable->getName(), new Number(x + 0.5 * k2)));
-        auto ev_func3 = function->eval(env);
-        auto num3 = dynamic_cast<Number*>(ev_func3);
-
-        if (num3 == nullptr)
+        double x2 = x1 - f1 * (x1 - x0) / (f1 - f0);
+        x0 = x1;
+        f0 = f1;
+        x1 = x2;
+        if (std::abs(x1 - x0) < tolerance)
         {
-            function->destroy();
-            delete function;
-            ev_func1->destroy();
-            delete ev_func1;
-            ev_func2->destroy();
-            delete ev_func2;
-            ev_func3->destroy();
-            return new Invalid("Expected that elements in the function evaluate to numeric values");
+            root = x1;
+            return nullptr;
         }
-        double k3 = h * num3->getNumber();
-
-        env.push_front(std::make_pair(variable->getName(), new Number(x + k3)));
-        auto ev_func4 = function->eval(env);
-        auto num4 = dynamic_cast<Number*>(ev_func4);
-
-        if (num4 == nullptr)
+        if (auto error = f(x1, f1))
         {
-            function->destroy();
-            delete function;
-            ev_func1->destroy();
-            delete ev_func1;
-            ev_func2->destroy();
-            delete ev_func2;
-            ev_func3->destroy();
-            delete ev_func3;
-            ev_func4->destroy();
-            delete ev_func4;
-            return new Invalid("Expected that elements in the function evaluate to numeric values");
+            return error;
         }
-        double k4 = h * num4->getNumber();
-
-        x = x + (1.0/6.0)*(k1 + 2*k2 + 2*k3 + k4);
-        t = t + h;
-
-        ev_func1->destroy();
-        delete ev_func1;
-        ev_func2->destroy();
-        delete ev_func2;
-        ev_func3->destroy();
-        delete ev_func3;
-        ev_func4->destroy();
-        delete ev_func4;
     }
-    function->destroy();
-    delete function;
-    return new Pair(new Number(t), new Number(x));
+    return new Impossible("Secant method did not converge");
 }
-Expression* ODEFirstOrderInitialValues::eval(Environment& env) const
+Expression* FindRoot::eval(Environment& env) const
 {
-    auto ini = initialValue->eval(env);
-    auto initialV = dynamic_cast<Pair*>(ini);
-
-    auto t0 = PairFirst{initialValue}.eval(env);
-    auto to = dynamic_cast<Number*>(t0);
-
-    auto x0 = PairSecond{initialValue}.eval(env);
-    auto xo = dynamic_cast<Number*>(x0);
+    auto evIn = interval->eval(env);
+    auto evInterval = dynamic_cast<Pair*>(evIn);
+    auto left = (evInterval != nullptr) ? dynamic_cast<Number*>(evInterval->getFirst()) : nullptr;
+    auto right = (evInterval != nullptr) ? dynamic_cast<Number*>(evInterval->getSecond()) : nullptr;
+    if (left == nullptr || right == nullptr)
+    {
+        evIn->destroy();
+        delete evIn;
+        return new Invalid("Expected a Pair of numeric values as interval");
+    }
+    double a = left->getNumber();
+    double b = right->getNumber();
+    evIn->destroy();
+    delete evIn;
+    if (a > b)
+    {
+        return new Invalid("Interval must be ordered as [init, final] where final > init");
+    }
 
-    auto tE = tFinal->eval(env);
-    auto tEval = dynamic_cast<Number*>(tE);
-    if (initialV == nullptr || to == nullptr || xo == nullptr || tEval == nullptr)
+    std::string methodName = "brent";
+    if (method != nullptr)
     {
-        ini->destroy();
-        delete ini;
-        t0->destroy();
-        delete t0;
-        x0->destroy();
-        delete x0;
-        tE->destroy();
-        delete tE;
-        return new Invalid("Invalid arguments received");
+        auto me = method->eval(env);
+        auto text = dynamic_cast<String*>(me);
+        if (text != nullptr)
+        {
+            methodName = text->getText();
+        }
+        me->destroy();
+        delete me;
+        if (text == nullptr || (methodName != "brent" && methodName != "newton" && methodName != "secant"))
+        {
+            return new Invalid("Root finding method must be \"brent\", \"newton\" or \"secant\"");
+        }
     }
-    double t = to->getNumber();
-    double x = xo->getNumber();
-    double f = tEval->getNumber();
-    double step = 0.1;
-    if (f < t)
+
+    double tol = 0.0000000001;
+    if (tolerance != nullptr)
     {
-        ini->destroy();
-        delete ini;
-        t0->destroy();
-        delete t0;
-        x0->destroy();
-        delete x0;
-        tE->destroy();
-        delete tE;
-        return new Impossible("Time interval must be ordered as [t_init, t_final] where t_final > t_init");
+        auto to = tolerance->eval(env);
+        auto num = dynamic_cast<Number*>(to);
+        if (num != nullptr)
+        {
+            tol = num->getNumber();
+        }
+        to->destroy();
+        delete to;
+        if (num == nullptr || tol <= 0)
+        {
+            return new Invalid("Tolerance must be a positive Number");
+        }
     }
-    auto va = variable->eval(env);
-    auto var = dynamic_cast<Name*>(va);
+
+    auto v = variable->eval(env);
+    auto var = dynamic_cast<Name*>(v);
     if (var == nullptr)
     {
-        ini->destroy();
-        delete ini;
-        t0->destroy();
-        delete t0;
-        x0->destroy();
-        delete x0;
-        tE->destroy();
-        delete tE;
-        va->destroy();
-        delete va;
-        new Invalid("ODE variable must be a Name");
+        v->destroy();
+        delete v;
+        return new Invalid("Variable must be a Name");
     }
+    std::string name = var->getName();
+    v->destroy();
+    delete v;
 
-    Environment envOde = std::forward_list<std::pair<std::string, Expression*>>{};
-
-    auto result = rungekuttaMethod(t, x, f, step, funct->eval(env), envOde, var);
+    auto evFunction = function->eval(env);
+    if (!containsName(evFunction, name, env))
+    {
+        std::string text = "Expected variable '" + name + "' in function " + function->toString();
+        evFunction->destroy();
+        delete evFunction;
+        return new Invalid(text);
+    }
 
-    for (auto& t : envOde)
+    double root = 0.0;
+    Expression* error = nullptr;
     {
-        if (t.second != nullptr)
+        PointEvaluator f{evFunction, name};
+        if (methodName == "newton")
         {
-            t.second->destroy();
-            delete t.second;
-            t.second = nullptr;
+            // Newton needs the derivative; when it is unavailable or the iteration escapes, Brent takes over
+            error = newtonMethod(a, b, tol, evFunction, name, root);
+            if (error != nullptr)
+            {
+                error->destroy();
+                delete error;
+                error = brentMethod(a, b, tol, f, root);
+            }
+        }
+        else if (methodName == "secant")
+        {
+            error = secantMethod(a, b, tol, f, root);
+        }
+        else
+        {
+            error = brentMethod(a, b, tol, f, root);
         }
     }
-    ini->destroy();
-    delete ini;
-    t0->destroy();
-    delete t0;
-    x0->destroy();
-    delete x0;
-    tE->destroy();
-    delete tE;
-    va->destroy();
-    delete va;
-    return result;
+    evFunction->destroy();
+    delete evFunction;
+
+    if (error != nullptr)
+    {
+        return error;
+    }
+    return new Number(root);
 }
-std::string ODEFirstOrderInitialValues::toString() const noexcept
+std::string FindRoot::toString() const noexcept
 {
-    return variable->toString() + "' = " + funct->toString() +"\n[t,"+ variable->toString()+"] = " + initialValue->toString() + "\nT_Final: " + tFinal->toString();
+    return "Interval: " + interval->toString() + " | Function: " + function->toString();
 }
-std::tuple<Expression*, Expression*, Expression*, Expression*> ODEFirstOrderInitialValues::getExpressions() const noexcept
+std::tuple<Expression*, Expression*, Expression*, Expression*, Expression*> FindRoot::getExpressions() const noexcept
 {
-    return std::make_tuple(funct, initialValue, tFinal, variable);
+    return std::make_tuple(interval, function, variable, method, tolerance);
 }
-void ODEFirstOrderInitialValues::destroy() noexcept
+void FindRoot::destroy() noexcept
 {
-    if (funct != nullptr)
-    {
-        funct->destroy();
-        delete funct;
-        funct = nullptr;
-    }
-    if (initialValue != nullptr)
+    if (interval != nullptr)
     {
-        initialValue->destroy();
-        delete initialValue;
-        initialValue = nullptr;
+        interval->destroy();
+        delete interval;
+        interval = nullptr;
     }
-    if (tFinal != nullptr)
+    if (function != nullptr)
     {
-        tFinal->destroy();
-        delete tFinal;
-        tFinal = nullptr;
+        function->destroy();
+        delete function;
+        function = nullptr;
     }
     if (variable != nullptr)
     {
@@ -2562,217 +4488,250 @@ void ODEFirstOrderInitialValues::destroy() noexcept
         delete variable;
         variable = nullptr;
     }
+    if (method != nullptr)
+    {
+        method->destroy();
+        delete method;
+        method = nullptr;
+    }
+    if (tolerance != nullptr)
+    {
+        tolerance->destroy();
+        delete tolerance;
+        tolerance = nullptr;
+    }
 }
 
-FindRootBisection::FindRootBisection(Expression* _interval, Expression* _function, Expression* _variable, Expression* _iterationLimit) : interval(_interval), function(_function), variable(_variable), iterationLimit(_iterationLimit) {}
-Expression* FindRootBisection::bisectionMethod(Number* left, Number* right, Expression* evFunction, Environment& env, Name* _variable, Number* _iterationLimit) const
+AllRoots::AllRoots(Expression* _interval, Expression* _function, Expression* _variable, Expression* _samples) : interval(_interval), function(_function), variable(_variable), samples(_samples) {}
+Expression* AllRoots::eval(Environment& env) const
 {
-    if (!left || !right || !evFunction || !_variable || !_iterationLimit)
+    auto evIn = interval->eval(env);
+    auto evInterval = dynamic_cast<Pair*>(evIn);
+    auto left = (evInterval != nullptr) ? dynamic_cast<Number*>(evInterval->getFirst()) : nullptr;
+    auto right = (evInterval != nullptr) ? dynamic_cast<Number*>(evInterval->getSecond()) : nullptr;
+    if (left == nullptr || right == nullptr)
     {
-        evFunction->destroy();
-        delete evFunction;
-        return new Invalid("Invalid arguments received");
+        evIn->destroy();
+        delete evIn;
+        return new Invalid("Expected a Pair of numeric values as interval");
     }
-    if (!containsName(evFunction, _variable->getName(), env))
+    double a = left->getNumber();
+    double b = right->getNumber();
+    evIn->destroy();
+    delete evIn;
+    if (a > b)
     {
-        std::string text = "Expected variable '" + _variable->getName() + "' in function " + function->toString();
-        evFunction->destroy();
-        delete evFunction;
-        return new Invalid(text);
+        return new Invalid("Interval must be ordered as [init, final] where final > init");
     }
 
-    double a = left->getNumber(), c = right->getNumber(), ep = 0.000001;
-    size_t il = _iterationLimit->getNumber();
-
-    std::string var = _variable->getName();
-
-    env.push_front(std::make_pair(var, left));
-    auto inter = evFunction->eval(env);
-    auto _ya = dynamic_cast<Number*>(inter);
+    auto sa = samples->eval(env);
+    auto sampleCount = dynamic_cast<Number*>(sa);
+    if (sampleCount == nullptr || sampleCount->getNumber() < 1)
+    {
+        sa->destroy();
+        delete sa;
+        return new Invalid("Number of subintervals must be a positive Number");
+    }
+    size_t n = sampleCount->getNumber();
+    sa->destroy();
+    delete sa;
 
-    env.push_front(std::make_pair(var, right));
+    auto v = variable->eval(env);
+    auto var = dynamic_cast<Name*>(v);
+    if (var == nullptr)
+    {
+        v->destroy();
+        delete v;
+        return new Invalid("Variable must be a Name");
+    }
+    std::string name = var->getName();
+    v->destroy();
+    delete v;
 
-    if (_ya == nullptr)
+    auto evFunction = function->eval(env);
+    if (!containsName(evFunction, name, env))
     {
+        std::string text = "Expected variable '" + name + "' in function " + function->toString();
         evFunction->destroy();
         delete evFunction;
-        inter->destroy();
-        delete inter;
-        return new Invalid("Expected that elements in the function evaluate to numeric values");
+        return new Invalid(text);
     }
-    double ya = _ya->getNumber();
 
-    auto inter2 = evFunction->eval(env);
-    auto _yc = dynamic_cast<Number*>(inter2);
-    if (_yc == nullptr)
+    auto& pool = ThreadPool::instance();
+    double h = (b - a) / n;
+    std::vector<double> grid(n + 1);
+    std::vector<double> values(n + 1);
+    for (size_t i = 0; i <= n; ++i)
     {
-        evFunction->destroy();
-        delete evFunction;
-        inter->destroy();
-        delete inter;
-        inter2->destroy();
-        delete inter2;
-        return new Invalid("Expected that elements in the function evaluate to numeric values");
+        grid[i] = (i == n) ? b : a + h * i;
     }
-    double yc_ = _yc->getNumber();
 
-    int it = 0;
-
-    while (++it <= il)
+    // Sample the grid in contiguous blocks, every block with its own evaluator
+    size_t blockSize = std::max<size_t>(1, (n + 1 + pool.size() - 1) / pool.size());
+    size_t blocks = (n + 1 + blockSize - 1) / blockSize;
+    std::vector<Expression*> errors(blocks, nullptr);
+    pool.parallelFor(blocks, [&](size_t block)
     {
-        double b = (a + c) / 2;
-        env.push_front(std::make_pair(var, new Number(b)));
-        auto yb_ = evFunction->eval(env);
-        auto _yb = dynamic_cast<Number*>(yb_);
-        if (_yb == nullptr)
+        PointEvaluator f{evFunction, name};
+        for (size_t i = block * blockSize; i < std::min(n + 1, (block + 1) * blockSize) && errors[block] == nullptr; ++i)
         {
-            yb_->destroy();
-            delete yb_;
-            break;
+            errors[block] = f(grid[i], values[i]);
         }
-        double yb = _yb->getNumber();
-        if (std::abs(b - a) < ep)
+    });
+
+    // Exact zeros on the grid are roots already; sign changes are refined below
+    std::vector<size_t> brackets{};
+    std::vector<double> roots(n + 1, 0.0);
+    std::vector<char> found(n + 1, false);
+    for (size_t i = 0; i <= n; ++i)
+    {
+        if (values[i] == 0)
         {
-            yb_->destroy();
-            delete yb_;
-            break;
+            roots[i] = grid[i];
+            found[i] = true;
         }
-        if (ya * yb <= 0)
+        else if (i < n && values[i] * values[i + 1] < 0)
         {
-            c = b;
-            yc_ = yb;
+            brackets.push_back(i);
         }
-        else
+    }
+
+    std::vector<Expression*> refineErrors(brackets.size(), nullptr);
+    bool sampled = std::all_of(errors.begin(), errors.end(), [](Expression* e) { return e == nullptr; });
+    if (sampled)
+    {
+        pool.parallelFor(brackets.size(), [&](size_t k)
         {
-            a = b;
-            ya = yb;
-        }
-        yb_->destroy();
-        delete yb_;
+            size_t i = brackets[k];
+            PointEvaluator f{evFunction, name};
+            double root = 0.0;
+            refineErrors[k] = FindRoot::brentMethod(grid[i], grid[i + 1], 0.0000000001, f, root);
+            if (refineErrors[k] == nullptr)
+            {
+                // Every bracket lies strictly inside its own grid cell, so this slot keeps the order sorted
+                roots[i] = root;
+                found[i] = true;
+            }
+        });
     }
     evFunction->destroy();
     delete evFunction;
-    inter->destroy();
-    delete inter;
-    inter2->destroy();
-    delete inter2;
-    return new Number((a + c) / 2);
-}
-Expression* FindRootBisection::eval(Environment& env) const
-{
-    auto evIn = interval->eval(env);
-    auto evInterval = dynamic_cast<Pair*>(evIn);
 
-    if (evInterval == nullptr)
+    Expression* error = nullptr;
+    errors.insert(errors.end(), refineErrors.begin(), refineErrors.end());
+    for (auto e : errors)
     {
-        auto pair = dynamic_cast<Value*>(evIn);
-        if (pair != nullptr)
+        if (e != nullptr && error == nullptr)
         {
-            std::string text = "Expected Pair, got "+ dataTypeToString(pair->getDataType());
-            evIn->destroy();
-            delete evIn;
-            return new Invalid(text);
+            error = e;
+        }
+        else if (e != nullptr)
+        {
+            e->destroy();
+            delete e;
         }
-        evIn->destroy();
-        delete evIn;
-        return new Invalid("Expected Pair, got different type");
     }
-    auto l = PairFirst{evInterval}.eval(env);
-    auto left = dynamic_cast<Number*>(l);
-    auto r = PairSecond{evInterval}.eval(env);
-    auto right = dynamic_cast<Number*>(r);
-
-    if (left == nullptr || right == nullptr)
+    if (error != nullptr)
     {
-        evIn->destroy();
-        delete evIn;
-        l->destroy();
-        delete l;
-        r->destroy();
-        delete r;
-        return new Invalid("Expected numeric values in the interval");
+        return error;
     }
 
-    if (left->getNumber() > right->getNumber())
+    std::vector<Expression*> result{};
+    for (size_t i = 0; i <= n; ++i)
     {
-        evIn->destroy();
-        delete evIn;
-        l->destroy();
-        delete l;
-        r->destroy();
-        delete r;
-        return new Invalid("Interval must be ordered as [init, final] where final > init");
+        if (found[i])
+        {
+            result.push_back(new Number(roots[i]));
+        }
     }
-    auto v = variable->eval(env);
-    auto var = dynamic_cast<Name*>(v);
+    return new Vector(result);
+}
+std::string AllRoots::toString() const noexcept
+{
+    return "Interval: " + interval->toString() + " | Function: " + function->toString();
+}
+std::tuple<Expression*, Expression*, Expression*, Expression*> AllRoots::getExpressions() const noexcept
+{
+    return std::make_tuple(interval, function, variable, samples);
+}
+void AllRoots::destroy() noexcept
+{
+    if (interval != nullptr)
+    {
+        interval->destroy();
+        delete interval;
+        interval = nullptr;
+    }
+    if (function != nullptr)
+    {
+        function->destroy();
+        delete function;
+        function = nullptr;
+    }
+    if (variable != nullptr)
+    {
+        variable->destroy();
+        delete variable;
+        variable = nullptr;
+    }
+    if (samples != nullptr)
+    {
+        samples->destroy();
+        delete samples;
+        samples = nullptr;
+    }
+}
 
+Derivative::Derivative(Expression* _function, Expression* _variable, Expression* _point) : function(_function), variable(_variable), point(_point) {}
+Expression* Derivative::eval(Environment& env) const
+{
+    auto va = variable->eval(env);
+    auto var = dynamic_cast<Name*>(va);
     if (var == nullptr)
     {
-        evIn->destroy();
-        delete evIn;
-        l->destroy();
-        delete l;
-        r->destroy();
-        delete r;
-        v->destroy();
-        delete v;
-        return new Invalid("Variable must be a Name");
+        va->destroy();
+        delete va;
+        return new Invalid("Differentiation variable must be a Name");
     }
 
-    auto ite = iterationLimit->eval(env);
-    auto it = dynamic_cast<Number*>(ite);
-
-    if (it == nullptr)
+    auto po = point->eval(env);
+    auto at = dynamic_cast<Number*>(po);
+    if (at == nullptr)
     {
-        evIn->destroy();
-        delete evIn;
-        l->destroy();
-        delete l;
-        r->destroy();
-        delete r;
-        v->destroy();
-        delete v;
-        ite->destroy();
-        delete ite;
-        return new Invalid("Iteration limit must be a Number");
+        va->destroy();
+        delete va;
+        po->destroy();
+        delete po;
+        return new Invalid("Expected a Number as differentiation point");
     }
 
-    Environment envBi = std::forward_list<std::pair<std::string, Expression*>>{};
-    auto result = bisectionMethod(left, right, function->eval(env), envBi, var, it);
-    for (auto& t : envBi)
+    auto fu = function->eval(env);
+    Dual dual{};
+    auto error = evalDual(fu, var->getName(), at->getNumber(), dual);
+
+    va->destroy();
+    delete va;
+    po->destroy();
+    delete po;
+    fu->destroy();
+    delete fu;
+
+    if (error != nullptr)
     {
-        if (t.second != nullptr)
-        {
-            t.second->destroy();
-            delete t.second;
-            t.second = nullptr;
-        }
+        return error;
     }
-
-    evIn->destroy();
-    delete evIn;
-    v->destroy();
-    delete v;
-    ite->destroy();
-    delete ite;
-    return result;
+    return new Number(dual.derivative);
 }
-std::string FindRootBisection::toString() const noexcept
+std::string Derivative::toString() const noexcept
 {
-    return "Interval: " + interval->toString() + " | Function: " + function->toString();
+    return "d/d" + variable->toString() + "(" + function->toString() + ") at " + point->toString();
 }
-std::tuple<Expression*, Expression*, Expression*, Expression*> FindRootBisection::getExpressions() const noexcept
+std::tuple<Expression*, Expression*, Expression*> Derivative::getExpressions() const noexcept
 {
-    return std::make_tuple(interval, function, variable, iterationLimit);
+    return std::make_tuple(function, variable, point);
 }
-void FindRootBisection::destroy() noexcept
+void Derivative::destroy() noexcept
 {
-    if (interval != nullptr)
-    {
-        interval->destroy();
-        delete interval;
-        interval = nullptr;
-    }
     if (function != nullptr)
     {
         function->destroy();
@@ -2785,19 +4744,23 @@ void FindRootBisection::destroy() noexcept
         delete variable;
         variable = nullptr;
     }
-    if (iterationLimit != nullptr)
+    if (point != nullptr)
     {
-        iterationLimit->destroy();
-        delete iterationLimit;
-        iterationLimit = nullptr;
+        point->destroy();
+        delete point;
+        point = nullptr;
     }
 }
 
 Display::Display(Expression* _expression) : expression(_expression) {}
+Expression* Display::getExpression() const noexcept
+{
+    return expression;
+}
 Expression* Display::eval(Environment& env) const
 {
     Expression* exp = expression->eval(env);
-    std::cout << exp->toString() << std::endl;
+    Output::instance().writeLine(*exp);
     exp->destroy();
     delete exp;
     return new Unit();
@@ -2823,7 +4786,7 @@ void Display::destroy() noexcept
 Print::Print(std::string _message) : message(_message) {}
 Expression* Print::eval(Environment&) const
 {
-    std::cout << message << std::endl;
+    Output::instance().writeMessage(message);
     return new Unit();
 }
 std::string Print::toString() const noexcept
@@ -2833,24 +4796,34 @@ std::string Print::toString() const noexcept
 void Print::destroy() noexcept {}
 
 Expression* Assigment::eval(Environment& env) const
+{
+    Expression* value = nullptr;
+    if (auto error = evalValue(env, value))
+    {
+        return error;
+    }
+    bind(env, value);
+    return new Unit();
+}
+Expression* Assigment::evalValue(Environment& env, Expression*& value) const
 {
     Name* leftName = dynamic_cast<Name*>(leftExpression);
 
-    if (leftName != nullptr)
+    if (leftName == nullptr)
     {
-        const std::string& name = leftName->getName();
-        if (!containsName(rightExpression, name, env))
-        {
-            env.push_front(std::make_pair(name, rightExpression->eval(env)));
-            return new Unit();
-        }
-        else
-        {
-            return new Invalid("Recursive assignment detected for variable '" + name + "'");
-        }
+        return new Invalid("Expected a Name for assignment");
     }
-
-    return new Invalid("Expected a Name for assignment");
+    const std::string& name = leftName->getName();
+    if (containsName(rightExpression, name, env))
+    {
+        return new Invalid("Recursive assignment detected for variable '" + name + "'");
+    }
+    value = rightExpression->eval(env);
+    return nullptr;
+}
+void Assigment::bind(Environment& env, Expression* value) const
+{
+    bindName(env, dynamic_cast<Name*>(leftExpression)->getName(), value);
 }
 std::string Assigment::toString() const noexcept
 {
@@ -2860,23 +4833,24 @@ std::string Assigment::toString() const noexcept
 ExpressionList::ExpressionList() : expressions{}, sz{0} {}
 Expression* ExpressionList::eval(Environment& env) const
 {
-    ExpressionList* exp_list = new ExpressionList();
-
-    for (auto &exp : expressions)
-    {
-        exp_list->addExpressionBack(exp->eval(env));
-    }
-
-    return exp_list;
+    return Scheduler(getVectorExpression()).run(env);
 }
 std::string ExpressionList::toString() const noexcept
 {
     std::string result;
+    print(result);
+    return result;
+}
+void ExpressionList::print(std::string& out) const
+{
     for (const auto& expr : expressions)
     {
-        result += (dynamic_cast<Unit*>(expr)) ? "" : expr->toString() + "\n";
+        if (dynamic_cast<Unit*>(expr) == nullptr)
+        {
+            expr->print(out);
+            out += "\n";
+        }
     }
-    return result;
 }
 void ExpressionList::addExpressionFront(Expression* expr)
 {
@@ -2909,4 +4883,75 @@ void ExpressionList::destroy() noexcept
         }
     }
     expressions.clear();
-}
\ No newline at end of file
+}
+
+// Number List
+NumberList::NumberList() : values{}, rows{1}, columns{0} {}
+Expression* NumberList::eval(Environment& env) const
+{
+    if (rows > 1)
+    {
+        return NumberList(*this).toMatrix();
+    }
+    std::vector<Expression*> vector{};
+    vector.reserve(values.size());
+    for (double value : values)
+    {
+        vector.push_back(new Number((std::abs(value) <= 0.0000000001) ? 0.0 : value));
+    }
+    return new Vector(vector);
+}
+std::string NumberList::toString() const noexcept
+{
+    std::string result;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        appendNumber(result, values[i]);
+        result += ((i + 1) % columns == 0) ? "\n" : "  ";
+    }
+    return result;
+}
+void NumberList::addNumber(double value)
+{
+    values.push_back(value);
+    ++columns;
+}
+bool NumberList::addRows(const NumberList& other)
+{
+    if (other.columns != columns)
+    {
+        return false;
+    }
+    values.insert(values.end(), other.values.begin(), other.values.end());
+    rows += other.rows;
+    return true;
+}
+const std::vector<double>& NumberList::getValues() const noexcept
+{
+    return values;
+}
+size_t NumberList::getRows() const noexcept
+{
+    return rows;
+}
+size_t NumberList::getColumns() const noexcept
+{
+    return columns;
+}
+Matrix* NumberList::toMatrix()
+{
+    // Rounded like Number::eval, so a literal prints the same as one built from Number nodes
+    for (double& value : values)
+    {
+        if (std::abs(value) <= 0.0000000001)
+        {
+            value = 0.0;
+        }
+    }
+    auto data = std::make_shared<std::vector<double>>(std::move(values));
+    return new Matrix(std::shared_ptr<const double>(data, data->data()), rows, columns);
+}
+void NumberList::destroy() noexcept
+{
+    values.clear();
+}
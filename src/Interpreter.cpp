@@ -0,0 +1,219 @@
+#include <Interpreter.hpp>
+#include <Output.hpp>
+
+Interpreter::Interpreter() : env{}, context{} {}
+Interpreter::~Interpreter()
+{
+    reset();
+}
+void Interpreter::execute(Expression* statement)
+{
+    std::unique_ptr<Expression> res(statement->eval(env));
+    if (dynamic_cast<Unit*>(res.get()) == nullptr)
+    {
+        Output::instance().writeLine(*res);
+    }
+    res->destroy();
+    statement->destroy();
+    delete statement;
+}
+void Interpreter::reportParseError()
+{
+    auto& output = Output::instance();
+    output.writeError("SyntaxError", context.error);
+    output.writeError("ParseError", "Parse failed!");
+}
+bool Interpreter::evaluate(std::string_view source, std::string& output)
+{
+    // fmemopen rejects an empty buffer
+    if (source.empty())
+    {
+        return true;
+    }
+    auto& out = Output::instance();
+    std::string* previous = out.getSink();
+    out.setSink(&output);
+
+    bool parsed = false;
+    FILE* input = fmemopen(const_cast<char*>(source.data()), source.size(), "r");
+    if (input != nullptr)
+    {
+        parsed = stream(input);
+        fclose(input);
+    }
+    else
+    {
+        out.writeError("InternalError", "Failed to create memory stream");
+    }
+
+    out.setSink(previous);
+    return parsed;
+}
+bool Interpreter::run(FILE* input)
+{
+    if (context.parse(input) != 0)
+    {
+        reportParseError();
+        return false;
+    }
+
+    Expression* statements = context.result;
+    context.result = nullptr;
+    run(*statements);
+    statements->destroy();
+    delete statements;
+    return true;
+}
+void Interpreter::run(const Expression& program)
+{
+    std::unique_ptr<Expression> res(program.eval(env));
+    if (auto results = dynamic_cast<ExpressionList*>(res.get()))
+    {
+        // One line, or one record, per displayed value
+        for (auto value : results->getVectorExpression())
+        {
+            if (dynamic_cast<Unit*>(value) == nullptr)
+            {
+                Output::instance().writeLine(*value);
+            }
+        }
+    }
+    res->destroy();
+}
+bool Interpreter::stream(FILE* input)
+{
+    context.statement_handler = [this](Expression* statement) { execute(statement); };
+    int result = context.parse(input);
+    context.statement_handler = nullptr;
+
+    if (result != 0)
+    {
+        reportParseError();
+        return false;
+    }
+    return true;
+}
+void Interpreter::setNumber(const std::string& name, double value)
+{
+    bindName(env, name, new Number(value));
+}
+Expression* Interpreter::evalBinding(const std::string& name) const
+{
+    auto binding = std::find_if(env.begin(), env.end(), [&name](const auto& pair) { return pair.first == name; });
+    if (binding == env.end() || dynamic_cast<Binding*>(binding->second) == nullptr)
+    {
+        return nullptr;
+    }
+    // Evaluating only reads the variables, the cache of the Binding has its own lock
+    return Name(name).eval(const_cast<Environment&>(env));
+}
+bool Interpreter::getNumber(const std::string& name, double& value) const
+{
+    Expression* evaluated = evalBinding(name);
+    auto number = dynamic_cast<const Number*>((evaluated != nullptr) ? evaluated : lookupName(env, name));
+    if (number != nullptr)
+    {
+        value = number->getNumber();
+    }
+    if (evaluated != nullptr)
+    {
+        evaluated->destroy();
+        delete evaluated;
+    }
+    return number != nullptr;
+}
+void Interpreter::setVector(const std::string& name, const double* values, size_t size)
+{
+    std::vector<Expression*> elements{};
+    elements.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        elements.push_back(new Number(values[i]));
+    }
+    bindName(env, name, new Vector(elements));
+}
+void Interpreter::setMatrix(const std::string& name, const double* values, size_t rows, size_t columns)
+{
+    std::shared_ptr<double> data(new double[rows * columns], std::default_delete<double[]>());
+    std::copy(values, values + rows * columns, data.get());
+    bindName(env, name, new Matrix(std::shared_ptr<const double>(std::move(data)), rows, columns));
+}
+// Copies a numeric Vector or Matrix row by row, false when an element is not a number
+static bool readArray(const Expression* value, std::vector<double>& values, std::vector<size_t>& shape)
+{
+    auto appendNumbers = [&values](const std::vector<Expression*>& elements)
+    {
+        for (auto element : elements)
+        {
+            auto number = dynamic_cast<const Number*>(element);
+            if (number == nullptr)
+            {
+                return false;
+            }
+            values.push_back(number->getNumber());
+        }
+        return true;
+    };
+
+    if (auto vector = dynamic_cast<const Vector*>(value))
+    {
+        shape = {vector->size()};
+        return appendNumbers(vector->getVectorExpression());
+    }
+    auto matrix = dynamic_cast<const Matrix*>(value);
+    if (matrix == nullptr)
+    {
+        return false;
+    }
+    if (matrix->isDense())
+    {
+        shape = {matrix->size(), matrix->getColumns()};
+        values.assign(matrix->getData(), matrix->getData() + matrix->size() * matrix->getColumns());
+        return true;
+    }
+    auto rows = matrix->getMatrixExpression();
+    for (auto row : rows)
+    {
+        auto vector = dynamic_cast<const Vector*>(row);
+        if (vector == nullptr || (!shape.empty() && vector->size() != shape[1]) || !appendNumbers(vector->getVectorExpression()))
+        {
+            return false;
+        }
+        shape = {rows.size(), vector->size()};
+    }
+    if (shape.empty())
+    {
+        shape = {0, 0};
+    }
+    return true;
+}
+bool Interpreter::getArray(const std::string& name, std::vector<double>& values, std::vector<size_t>& shape) const
+{
+    values.clear();
+    shape.clear();
+    Expression* evaluated = evalBinding(name);
+    bool found = readArray((evaluated != nullptr) ? evaluated : lookupName(env, name), values, shape);
+    if (evaluated != nullptr)
+    {
+        evaluated->destroy();
+        delete evaluated;
+    }
+    return found;
+}
+void Interpreter::reset()
+{
+    for (auto& t : env)
+    {
+        if (t.second != nullptr)
+        {
+            t.second->destroy();
+            delete t.second;
+            t.second = nullptr;
+        }
+    }
+    env.clear();
+}
+const Environment& Interpreter::getEnvironment() const noexcept
+{
+    return env;
+}
@@ -0,0 +1,610 @@
+#include <MemoCache.hpp>
+#include <Expression.hpp>
+#include <cerrno>
+#include <cstring>
+#include <tuple>
+#include <typeinfo>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // Bookkeeping of an entry besides its key and value: list node, index slot and allocations
+    constexpr size_t ENTRY_OVERHEAD = 128;
+
+    // Part of the name of every file, results of another version are never read. Change it when
+    // a cached builtin or the key changes
+    constexpr char INTERPRETER_VERSION[] = "mpl-1";
+    constexpr char FILE_MAGIC[8] = {'M', 'P', 'L', 'M', 'E', 'M', 'O', '1'};
+    constexpr char FILE_EXTENSION[] = ".mplc";
+    // Files are removed down to this share of the limit, so a full directory is not scanned on
+    // every write
+    constexpr size_t TRIM_PERCENT = 90;
+
+    enum class StoredKind : uint32_t
+    {
+        Number,
+        Vector,
+        Matrix,
+        // Printed without rounding tiny values to zero, so loaded back in the same form
+        DenseMatrix
+    };
+
+    // Followed by the key, padding to 8 bytes and the values in row-major order
+    struct FileHeader
+    {
+        char magic[8];
+        StoredKind kind;
+        // Files written on a host of the other byte order do not match
+        uint32_t byteOrder;
+        uint64_t rows;
+        uint64_t columns;
+        uint64_t keyLength;
+    };
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    size_t dataOffset(size_t keyLength)
+    {
+        return (sizeof(FileHeader) + keyLength + 7) / 8 * 8;
+    }
+
+    // FNV-1a, file names must not change between builds
+    uint64_t hashKey(std::string_view key)
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (unsigned char c : key)
+        {
+            hash = (hash ^ c) * 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    // The numbers of a value in row-major order, false when it is not a number or a vector or
+    // matrix of numbers
+    bool flatten(const Expression& value, StoredKind& kind, size_t& rows, size_t& columns, std::vector<double>& data)
+    {
+        auto appendNumbers = [&data](const std::vector<Expression*>& elements)
+        {
+            for (auto element : elements)
+            {
+                auto number = dynamic_cast<Number*>(element);
+                if (number == nullptr)
+                {
+                    return false;
+                }
+                data.push_back(number->getNumber());
+            }
+            return true;
+        };
+        if (auto number = dynamic_cast<const Number*>(&value))
+        {
+            kind = StoredKind::Number;
+            rows = columns = 1;
+            data.push_back(number->getNumber());
+            return true;
+        }
+        if (auto vector = dynamic_cast<const Vector*>(&value))
+        {
+            kind = StoredKind::Vector;
+            rows = 1;
+            columns = vector->getVectorExpression().size();
+            return appendNumbers(vector->getVectorExpression());
+        }
+        auto matrix = dynamic_cast<const Matrix*>(&value);
+        if (matrix == nullptr)
+        {
+            return false;
+        }
+        kind = matrix->isDense() ? StoredKind::DenseMatrix : StoredKind::Matrix;
+        rows = matrix->size();
+        columns = matrix->getColumns();
+        if (matrix->isDense())
+        {
+            data.assign(matrix->getData(), matrix->getData() + rows * columns);
+            return true;
+        }
+        // Only dense matrices know their columns, every row must have as many as the first
+        auto matrixRows = matrix->getMatrixExpression();
+        auto first = matrixRows.empty() ? nullptr : dynamic_cast<Vector*>(matrixRows.front());
+        columns = (first != nullptr) ? first->getVectorExpression().size() : 0;
+        for (auto row : matrixRows)
+        {
+            auto vector = dynamic_cast<Vector*>(row);
+            if (vector == nullptr || vector->getVectorExpression().size() != columns || !appendNumbers(vector->getVectorExpression()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T>
+    void appendRaw(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void appendText(std::string& out, char tag, const std::string& text)
+    {
+        out += tag;
+        appendRaw(out, static_cast<uint64_t>(text.size()));
+        out += text;
+    }
+
+    // Appends a structural copy of an evaluated value: numbers by their bits, dense matrices by
+    // their buffer and symbolic expressions node by node. False for anything else
+    bool appendKey(std::string& out, Expression* expr)
+    {
+        if (auto number = dynamic_cast<Number*>(expr))
+        {
+            out += 'n';
+            appendRaw(out, number->getNumber());
+            return true;
+        }
+        if (auto matrix = dynamic_cast<Matrix*>(expr))
+        {
+            if (matrix->isDense())
+            {
+                out += 'D';
+                appendRaw(out, static_cast<uint64_t>(matrix->size()));
+                appendRaw(out, static_cast<uint64_t>(matrix->getColumns()));
+                out.append(reinterpret_cast<const char*>(matrix->getData()), matrix->size() * matrix->getColumns() * sizeof(double));
+                return true;
+            }
+            auto rows = matrix->getMatrixExpression();
+            out += 'M';
+            appendRaw(out, static_cast<uint64_t>(rows.size()));
+            return std::all_of(rows.begin(), rows.end(), [&out](Expression* row) { return appendKey(out, row); });
+        }
+        if (auto vector = dynamic_cast<Vector*>(expr))
+        {
+            auto elements = vector->getVectorExpression();
+            out += 'V';
+            appendRaw(out, static_cast<uint64_t>(elements.size()));
+            return std::all_of(elements.begin(), elements.end(), [&out](Expression* element) { return appendKey(out, element); });
+        }
+        if (auto pair = dynamic_cast<Pair*>(expr))
+        {
+            out += 'P';
+            return appendKey(out, pair->getFirst()) && appendKey(out, pair->getSecond());
+        }
+        if (auto name = dynamic_cast<Name*>(expr))
+        {
+            appendText(out, 'N', name->getName());
+            return true;
+        }
+        if (auto text = dynamic_cast<String*>(expr))
+        {
+            appendText(out, 'S', text->getText());
+            return true;
+        }
+        if (dynamic_cast<PI*>(expr) != nullptr || dynamic_cast<EULER*>(expr) != nullptr)
+        {
+            out += (dynamic_cast<PI*>(expr) != nullptr) ? 'p' : 'e';
+            return true;
+        }
+        // Operators have a fixed number of operands, so their type and the operands in order
+        // identify them
+        if (auto binary = dynamic_cast<BinaryExpression*>(expr))
+        {
+            appendText(out, 'B', typeid(*expr).name());
+            return appendKey(out, binary->getLeftExpression()) && appendKey(out, binary->getRightExpression());
+        }
+        if (auto unary = dynamic_cast<UnaryExpression*>(expr))
+        {
+            appendText(out, 'U', typeid(*expr).name());
+            return appendKey(out, unary->getExpression());
+        }
+        return false;
+    }
+
+    // An exact copy of a numeric value, eval would round tiny numbers to zero. Adds the memory
+    // it takes to bytes, returns nullptr for any other value
+    Expression* copyValue(const Expression& value, size_t& bytes)
+    {
+        if (auto number = dynamic_cast<const Number*>(&value))
+        {
+            bytes += sizeof(Number);
+            return new Number(number->getNumber());
+        }
+        auto copyAll = [&bytes](const std::vector<Expression*>& elements, std::vector<Expression*>& copies)
+        {
+            bytes += elements.size() * sizeof(Expression*);
+            for (auto element : elements)
+            {
+                auto copy = (element != nullptr) ? copyValue(*element, bytes) : nullptr;
+                if (copy == nullptr)
+                {
+                    for (auto done : copies)
+                    {
+                        done->destroy();
+                        delete done;
+                    }
+                    return false;
+                }
+                copies.push_back(copy);
+            }
+            return true;
+        };
+        std::vector<Expression*> copies{};
+        if (auto vector = dynamic_cast<const Vector*>(&value))
+        {
+            bytes += sizeof(Vector);
+            return copyAll(vector->getVectorExpression(), copies) ? new Vector(copies) : nullptr;
+        }
+        auto matrix = dynamic_cast<const Matrix*>(&value);
+        if (matrix == nullptr)
+        {
+            return nullptr;
+        }
+        bytes += sizeof(Matrix);
+        if (matrix->isDense())
+        {
+            // The buffer is shared and never written
+            bytes += matrix->size() * matrix->getColumns() * sizeof(double);
+            Environment empty{};
+            return matrix->eval(empty);
+        }
+        return copyAll(matrix->getMatrixExpression(), copies) ? new Matrix(copies) : nullptr;
+    }
+}
+
+MemoCache::MemoCache() : entries{}, index{}, budget{0}, bytes{0}, hits{0}, misses{0}, diskHits{0}, mutex{},
+    directory{}, diskLimit{0}, persistent{false}, diskBytes{0}, diskMutex{} {}
+MemoCache::~MemoCache()
+{
+    clear();
+}
+MemoCache& MemoCache::instance()
+{
+    static MemoCache cache{};
+    return cache;
+}
+void MemoCache::evict(size_t limit)
+{
+    while (bytes > limit && !entries.empty())
+    {
+        auto& last = entries.back();
+        index.erase(last.key);
+        bytes -= last.bytes;
+        last.value->destroy();
+        delete last.value;
+        entries.pop_back();
+    }
+}
+void MemoCache::setBudget(size_t _budget)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    budget = _budget;
+    evict(_budget);
+}
+size_t MemoCache::getBudget() const noexcept
+{
+    return budget;
+}
+bool MemoCache::isEnabled() const noexcept
+{
+    return budget.load(std::memory_order_relaxed) > 0 || persistent.load(std::memory_order_relaxed);
+}
+bool MemoCache::setDirectory(std::string path, size_t limit)
+{
+    if (::mkdir(path.c_str(), 0777) != 0 && errno != EEXIST)
+    {
+        return false;
+    }
+    DIR* dir = ::opendir(path.c_str());
+    if (dir == nullptr)
+    {
+        return false;
+    }
+    ::closedir(dir);
+    directory = std::move(path);
+    diskLimit = limit;
+    persistent = limit > 0;
+    trim(limit);
+    return true;
+}
+Expression* MemoCache::find(MemoOperation operation, std::initializer_list<Expression*> arguments, std::string& key)
+{
+    key.clear();
+    if (!isEnabled())
+    {
+        return nullptr;
+    }
+    key += static_cast<char>(operation);
+    for (auto argument : arguments)
+    {
+        if (!appendKey(key, argument))
+        {
+            key.clear();
+            return nullptr;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found != index.end())
+    {
+        ++hits;
+        entries.splice(entries.begin(), entries, found->second);
+        size_t copied = 0;
+        return copyValue(*found->second->value, copied);
+    }
+    if (!persistent)
+    {
+        ++misses;
+        return nullptr;
+    }
+    lock.unlock();
+    Expression* loaded = load(key);
+    lock.lock();
+    if (loaded == nullptr)
+    {
+        ++misses;
+        return nullptr;
+    }
+    ++hits;
+    ++diskHits;
+    lock.unlock();
+    remember(key, *loaded);
+    return loaded;
+}
+void MemoCache::store(std::string key, const Expression& result)
+{
+    if (key.empty())
+    {
+        return;
+    }
+    if (persistent)
+    {
+        save(key, result);
+    }
+    remember(std::move(key), result);
+}
+void MemoCache::remember(std::string key, const Expression& result)
+{
+    if (budget == 0)
+    {
+        return;
+    }
+    size_t valueBytes = 0;
+    Expression* value = copyValue(result, valueBytes);
+    if (value == nullptr)
+    {
+        return;
+    }
+    size_t entryBytes = valueBytes + key.size() + ENTRY_OVERHEAD;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Another thread may have stored the same result in the meantime
+    if (entryBytes > budget || index.count(key) != 0)
+    {
+        value->destroy();
+        delete value;
+        return;
+    }
+    entries.push_front(Entry{std::move(key), value, entryBytes});
+    index.emplace(entries.front().key, entries.begin());
+    bytes += entryBytes;
+    evict(budget);
+}
+uint64_t MemoCache::getHits() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+uint64_t MemoCache::getMisses() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+uint64_t MemoCache::getDiskHits() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return diskHits;
+}
+size_t MemoCache::getBytes() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+}
+size_t MemoCache::size() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+void MemoCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    evict(0);
+}
+Expression* MemoCache::load(const std::string& key)
+{
+    std::string fileKey = std::string(INTERPRETER_VERSION) + '\0' + key;
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx", static_cast<unsigned long long>(hashKey(fileKey)));
+    std::string path = directory + name + FILE_EXTENSION;
+
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return nullptr;
+    }
+    struct stat info{};
+    if (::fstat(descriptor, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader))
+    {
+        ::close(descriptor);
+        return nullptr;
+    }
+    size_t length = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        ::close(descriptor);
+        return nullptr;
+    }
+    auto base = static_cast<const char*>(mapping);
+    FileHeader header{};
+    std::memcpy(&header, base, sizeof(header));
+    size_t offset = dataOffset(header.keyLength);
+    // Equal hashes of different keys are told apart by the key in the file
+    bool valid = std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 && header.byteOrder == BYTE_ORDER_MARK &&
+                 header.kind <= StoredKind::DenseMatrix && header.keyLength == fileKey.size() && offset <= length &&
+                 header.rows > 0 && header.columns <= (length - offset) / sizeof(double) / header.rows &&
+                 offset + header.rows * header.columns * sizeof(double) == length &&
+                 std::memcmp(base + sizeof(FileHeader), fileKey.data(), fileKey.size()) == 0;
+    if (!valid)
+    {
+        ::close(descriptor);
+        ::munmap(mapping, length);
+        return nullptr;
+    }
+    // The modification time orders the files for trim
+    ::futimens(descriptor, nullptr);
+    ::close(descriptor);
+
+    auto values = reinterpret_cast<const double*>(base + offset);
+    if (header.kind == StoredKind::DenseMatrix)
+    {
+        std::shared_ptr<const double> data(values, [mapping, length](const double*) { ::munmap(mapping, length); });
+        return new Matrix(std::move(data), header.rows, header.columns);
+    }
+    auto numbers = [values, &header](size_t row)
+    {
+        std::vector<Expression*> elements{};
+        elements.reserve(header.columns);
+        for (size_t i = 0; i < header.columns; ++i)
+        {
+            elements.push_back(new Number(values[row * header.columns + i]));
+        }
+        return elements;
+    };
+    Expression* result = nullptr;
+    if (header.kind == StoredKind::Number)
+    {
+        result = new Number(values[0]);
+    }
+    else if (header.kind == StoredKind::Vector)
+    {
+        auto elements = numbers(0);
+        result = new Vector(elements);
+    }
+    else
+    {
+        std::vector<Expression*> matrixRows{};
+        for (size_t row = 0; row < header.rows; ++row)
+        {
+            auto elements = numbers(row);
+            matrixRows.push_back(new Vector(elements));
+        }
+        result = new Matrix(matrixRows);
+    }
+    ::munmap(mapping, length);
+    return result;
+}
+void MemoCache::save(const std::string& key, const Expression& result)
+{
+    FileHeader header{};
+    std::vector<double> data{};
+    size_t rows = 0;
+    size_t columns = 0;
+    if (!flatten(result, header.kind, rows, columns, data) || data.empty())
+    {
+        return;
+    }
+    std::string fileKey = std::string(INTERPRETER_VERSION) + '\0' + key;
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.rows = rows;
+    header.columns = columns;
+    header.keyLength = fileKey.size();
+    size_t padding = dataOffset(fileKey.size()) - sizeof(FileHeader) - fileKey.size();
+    size_t length = dataOffset(fileKey.size()) + data.size() * sizeof(double);
+    if (length > diskLimit)
+    {
+        return;
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx", static_cast<unsigned long long>(hashKey(fileKey)));
+    std::string path = directory + name + FILE_EXTENSION;
+    // Written under a name of its own and renamed, so readers in other threads or processes
+    // only ever see complete files
+    static std::atomic<uint64_t> written{0};
+    std::string temporary = path + "." + std::to_string(::getpid()) + "." + std::to_string(written++) + ".tmp";
+
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return;
+    }
+    const char zeros[8] = {};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(fileKey.data(), 1, fileKey.size(), file) == fileKey.size() &&
+              std::fwrite(zeros, 1, padding, file) == padding &&
+              std::fwrite(data.data(), sizeof(double), data.size(), file) == data.size();
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary.c_str());
+        return;
+    }
+    if ((diskBytes += length) > diskLimit)
+    {
+        trim(diskLimit / 100 * TRIM_PERCENT);
+    }
+}
+void MemoCache::trim(size_t limit)
+{
+    std::lock_guard<std::mutex> lock(diskMutex);
+    DIR* dir = ::opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        return;
+    }
+    struct CacheFile
+    {
+        std::string path;
+        struct timespec used;
+        size_t size;
+    };
+    std::vector<CacheFile> files{};
+    size_t total = 0;
+    std::string_view extension = FILE_EXTENSION;
+    while (auto entry = ::readdir(dir))
+    {
+        std::string_view name = entry->d_name;
+        if (name.size() <= extension.size() || name.substr(name.size() - extension.size()) != extension)
+        {
+            continue;
+        }
+        std::string path = directory + "/" + std::string(name);
+        struct stat info{};
+        if (::stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode))
+        {
+            files.push_back(CacheFile{std::move(path), info.st_mtim, static_cast<size_t>(info.st_size)});
+            total += static_cast<size_t>(info.st_size);
+        }
+    }
+    ::closedir(dir);
+
+    if (total > limit)
+    {
+        std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b)
+        {
+            return std::tie(a.used.tv_sec, a.used.tv_nsec) < std::tie(b.used.tv_sec, b.used.tv_nsec);
+        });
+        // Results that are mapped stay readable until they are unmapped
+        for (size_t i = 0; i < files.size() && total > limit; ++i)
+        {
+            if (::unlink(files[i].path.c_str()) == 0 || errno == ENOENT)
+            {
+                total -= files[i].size;
+            }
+        }
+    }
+    diskBytes = total;
+}
@@ -0,0 +1,566 @@
+#include <Output.hpp>
+#include <Expression.hpp>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+void appendNumber(std::string& out, double value)
+{
+    // Large enough for any double in fixed notation with MAX_PRECISION decimals
+    char text[320 + Output::MAX_PRECISION];
+    auto [end, ec] = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, Output::instance().getPrecision());
+    out.append(text, end);
+}
+
+namespace
+{
+    // Shortest text that reads back as the same double
+    void appendShortest(std::string& out, double value)
+    {
+        char text[32];
+        auto [end, ec] = std::to_chars(text, text + sizeof(text), value);
+        out.append(text, end);
+    }
+
+    void appendJsonNumber(std::string& out, double value)
+    {
+        // JSON has no representation for NaN or infinities
+        if (!std::isfinite(value))
+        {
+            out += "null";
+            return;
+        }
+        appendShortest(out, value);
+    }
+
+    void appendJsonString(std::string& out, std::string_view text)
+    {
+        out += '"';
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            }
+            else
+            {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+
+    void appendJson(std::string& out, const Expression& value);
+
+    // Numbers inside data arrays are written bare, anything else as a nested record
+    void appendJsonElement(std::string& out, const Expression& value)
+    {
+        if (auto number = dynamic_cast<const Number*>(&value))
+        {
+            appendJsonNumber(out, number->getNumber());
+            return;
+        }
+        appendJson(out, value);
+    }
+
+    void appendJsonShape(std::string& out, std::initializer_list<size_t> shape)
+    {
+        out += ",\"shape\":[";
+        for (auto dimension = shape.begin(); dimension != shape.end(); ++dimension)
+        {
+            out += (dimension == shape.begin()) ? "" : ",";
+            out += std::to_string(*dimension);
+        }
+        out += "]";
+    }
+
+    void appendJson(std::string& out, const Expression& value)
+    {
+        if (auto number = dynamic_cast<const Number*>(&value))
+        {
+            out += "{\"type\":\"Number\",\"value\":";
+            appendJsonNumber(out, number->getNumber());
+        }
+        else if (auto vector = dynamic_cast<const Vector*>(&value))
+        {
+            auto elements = vector->getVectorExpression();
+            out += "{\"type\":\"Vector\"";
+            appendJsonShape(out, {elements.size()});
+            out += ",\"data\":[";
+            for (size_t i = 0; i < elements.size(); ++i)
+            {
+                out += (i == 0) ? "" : ",";
+                appendJsonElement(out, *elements[i]);
+            }
+            out += "]";
+        }
+        else if (auto matrix = dynamic_cast<const Matrix*>(&value))
+        {
+            out += "{\"type\":\"Matrix\"";
+            if (matrix->isDense())
+            {
+                size_t count = matrix->size() * matrix->getColumns();
+                appendJsonShape(out, {matrix->size(), matrix->getColumns()});
+                out += ",\"data\":[";
+                for (size_t i = 0; i < count; ++i)
+                {
+                    out += (i == 0) ? "" : ",";
+                    appendJsonNumber(out, matrix->getData()[i]);
+                }
+            }
+            else
+            {
+                auto rows = matrix->getMatrixExpression();
+                auto first = rows.empty() ? nullptr : dynamic_cast<const Vector*>(rows[0]);
+                appendJsonShape(out, {rows.size(), (first != nullptr) ? first->size() : 0});
+                out += ",\"data\":[";
+                bool separator = false;
+                for (auto row : rows)
+                {
+                    auto vector = dynamic_cast<const Vector*>(row);
+                    for (auto element : (vector != nullptr) ? vector->getVectorExpression() : std::vector<Expression*>{row})
+                    {
+                        out += separator ? "," : "";
+                        appendJsonElement(out, *element);
+                        separator = true;
+                    }
+                }
+            }
+            out += "]";
+        }
+        else if (auto pair = dynamic_cast<const Pair*>(&value))
+        {
+            out += "{\"type\":\"Pair\",\"data\":[";
+            appendJsonElement(out, *pair->getFirst());
+            out += ",";
+            appendJsonElement(out, *pair->getSecond());
+            out += "]";
+        }
+        else if (auto points = dynamic_cast<const Points*>(&value))
+        {
+            auto columns = points->getColumns();
+            out += "{\"type\":\"Points\"";
+            appendJsonShape(out, {columns->x.size(), 2});
+            out += ",\"data\":[";
+            for (size_t i = 0; i < columns->x.size(); ++i)
+            {
+                out += (i == 0) ? "" : ",";
+                appendJsonNumber(out, columns->x[i]);
+                out += ",";
+                appendJsonNumber(out, columns->y[i]);
+            }
+            out += "]";
+        }
+        else if (auto text = dynamic_cast<const String*>(&value))
+        {
+            out += "{\"type\":\"String\",\"value\":";
+            appendJsonString(out, text->getText());
+        }
+        else if (auto name = dynamic_cast<const Name*>(&value))
+        {
+            out += "{\"type\":\"Name\",\"value\":";
+            appendJsonString(out, name->getName());
+        }
+        else if (auto invalid = dynamic_cast<const Invalid*>(&value))
+        {
+            out += "{\"type\":\"Invalid\",\"error\":";
+            appendJsonString(out, invalid->getMessage());
+        }
+        else if (auto impossible = dynamic_cast<const Impossible*>(&value))
+        {
+            out += "{\"type\":\"Impossible\",\"error\":";
+            appendJsonString(out, impossible->getMessage());
+        }
+        else
+        {
+            // Symbolic results and other values are described by their text
+            auto other = dynamic_cast<const Value*>(&value);
+            out += "{\"type\":";
+            appendJsonString(out, (other != nullptr) ? dataTypeToString(other->getDataType()) : "Expression");
+            out += ",\"text\":";
+            appendJsonString(out, value.toString());
+        }
+        out += "}";
+    }
+
+    enum class RecordTag : uint8_t
+    {
+        Text = 0,
+        Number = 1,
+        Vector = 2,
+        Matrix = 3,
+        Pair = 4,
+        Points = 5,
+        Invalid = 6,
+        Impossible = 7,
+        Error = 8
+    };
+
+    bool littleEndianHost() noexcept
+    {
+        uint16_t probe = 1;
+        return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+    }
+
+    // Records are little-endian whatever the host
+    template <typename T>
+    void appendRaw(std::string& out, T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if (!littleEndianHost())
+        {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        out.append(bytes, sizeof(T));
+    }
+
+    void appendDoubles(std::string& out, const double* values, size_t count)
+    {
+        if (littleEndianHost())
+        {
+            out.append(reinterpret_cast<const char*>(values), count * sizeof(double));
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            appendRaw(out, values[i]);
+        }
+    }
+
+    void appendRecordHeader(std::string& out, RecordTag tag, std::initializer_list<uint64_t> shape)
+    {
+        appendRaw(out, static_cast<uint8_t>(tag));
+        appendRaw(out, static_cast<uint8_t>(shape.size()));
+        out.append(6, '\0');
+        for (uint64_t dimension : shape)
+        {
+            appendRaw(out, dimension);
+        }
+    }
+
+    void appendTextRecord(std::string& out, RecordTag tag, std::string_view text)
+    {
+        appendRecordHeader(out, tag, {});
+        appendRaw(out, static_cast<uint64_t>(text.size()));
+        out.append(text);
+    }
+
+    // Collects the elements as doubles, false when one of them is not a Number
+    bool numericElements(const std::vector<Expression*>& elements, std::vector<double>& values)
+    {
+        for (auto element : elements)
+        {
+            auto number = dynamic_cast<const Number*>(element);
+            if (number == nullptr)
+            {
+                return false;
+            }
+            values.push_back(number->getNumber());
+        }
+        return true;
+    }
+
+    // Collects the rows of a matrix of numbers, false when a row is not a Vector of numbers or
+    // the rows differ in length
+    bool numericMatrix(const Matrix& matrix, std::vector<double>& values, size_t& columns)
+    {
+        if (matrix.isDense())
+        {
+            columns = matrix.getColumns();
+            values.assign(matrix.getData(), matrix.getData() + matrix.size() * columns);
+            return true;
+        }
+        auto rows = matrix.getMatrixExpression();
+        columns = 0;
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            auto row = dynamic_cast<const Vector*>(rows[i]);
+            if (row == nullptr || (i > 0 && row->size() != columns) || !numericElements(row->getVectorExpression(), values))
+            {
+                return false;
+            }
+            columns = row->size();
+        }
+        return !rows.empty();
+    }
+
+    void appendRecord(std::string& out, const Expression& value)
+    {
+        std::vector<double> values{};
+        if (auto number = dynamic_cast<const Number*>(&value))
+        {
+            appendRecordHeader(out, RecordTag::Number, {});
+            appendRaw(out, number->getNumber());
+            return;
+        }
+        else if (auto vector = dynamic_cast<const Vector*>(&value); vector != nullptr && numericElements(vector->getVectorExpression(), values))
+        {
+            appendRecordHeader(out, RecordTag::Vector, {values.size()});
+        }
+        else if (auto matrix = dynamic_cast<const Matrix*>(&value); matrix != nullptr && matrix->isDense())
+        {
+            appendRecordHeader(out, RecordTag::Matrix, {matrix->size(), matrix->getColumns()});
+            appendDoubles(out, matrix->getData(), matrix->size() * matrix->getColumns());
+            return;
+        }
+        else if (size_t columns = 0; matrix != nullptr)
+        {
+            if (!numericMatrix(*matrix, values, columns))
+            {
+                appendTextRecord(out, RecordTag::Text, value.toString());
+                return;
+            }
+            appendRecordHeader(out, RecordTag::Matrix, {matrix->size(), columns});
+        }
+        else if (auto pair = dynamic_cast<const Pair*>(&value); pair != nullptr && numericElements({pair->getFirst(), pair->getSecond()}, values))
+        {
+            appendRecordHeader(out, RecordTag::Pair, {2});
+        }
+        else if (auto points = dynamic_cast<const Points*>(&value))
+        {
+            auto columns = points->getColumns();
+            appendRecordHeader(out, RecordTag::Points, {columns->x.size(), 2});
+            for (size_t i = 0; i < columns->x.size(); ++i)
+            {
+                appendRaw(out, columns->x[i]);
+                appendRaw(out, columns->y[i]);
+            }
+            return;
+        }
+        else if (auto invalid = dynamic_cast<const Invalid*>(&value))
+        {
+            appendTextRecord(out, RecordTag::Invalid, invalid->getMessage());
+            return;
+        }
+        else if (auto impossible = dynamic_cast<const Impossible*>(&value))
+        {
+            appendTextRecord(out, RecordTag::Impossible, impossible->getMessage());
+            return;
+        }
+        else
+        {
+            appendTextRecord(out, RecordTag::Text, value.toString());
+            return;
+        }
+        appendDoubles(out, values.data(), values.size());
+    }
+
+    void appendCsvText(std::string& out, std::string_view text)
+    {
+        out += '"';
+        for (char c : text)
+        {
+            if (c == '"')
+            {
+                out += '"';
+            }
+            out += c;
+        }
+        out += '"';
+    }
+
+    // Numbers are bare cells, vectors, matrices, pairs and points give one cell per element row
+    // by row, anything else is its quoted text
+    void appendCsv(std::string& out, const Expression& value)
+    {
+        std::vector<double> values{};
+        size_t columns = 0;
+        auto vector = dynamic_cast<const Vector*>(&value);
+        auto matrix = dynamic_cast<const Matrix*>(&value);
+        auto pair = dynamic_cast<const Pair*>(&value);
+        auto points = dynamic_cast<const Points*>(&value);
+        bool numeric = false;
+        if (auto number = dynamic_cast<const Number*>(&value))
+        {
+            values.push_back(number->getNumber());
+            numeric = true;
+        }
+        else if (vector != nullptr)
+        {
+            numeric = numericElements(vector->getVectorExpression(), values);
+        }
+        else if (matrix != nullptr)
+        {
+            numeric = numericMatrix(*matrix, values, columns);
+        }
+        else if (pair != nullptr)
+        {
+            numeric = numericElements({pair->getFirst(), pair->getSecond()}, values);
+        }
+        else if (points != nullptr)
+        {
+            auto data = points->getColumns();
+            for (size_t i = 0; i < data->x.size(); ++i)
+            {
+                values.push_back(data->x[i]);
+                values.push_back(data->y[i]);
+            }
+            numeric = true;
+        }
+        if (!numeric)
+        {
+            std::string text{};
+            value.print(text);
+            appendCsvText(out, text);
+            return;
+        }
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            out += (i == 0) ? "" : ",";
+            appendShortest(out, values[i]);
+        }
+    }
+}
+
+thread_local std::string Output::scratch{};
+thread_local std::string* Output::sink{nullptr};
+
+Output::Output() : format{OutputFormat::Text}, precision{6}, elision{0}
+{
+    if (!isatty(fileno(stdout)))
+    {
+        std::setvbuf(stdout, nullptr, _IOFBF, 1 << 20);
+    }
+}
+Output& Output::instance()
+{
+    static Output output{};
+    return output;
+}
+void Output::setFormat(OutputFormat _format) noexcept
+{
+    format = _format;
+}
+OutputFormat Output::getFormat() const noexcept
+{
+    return format;
+}
+void Output::setPrecision(int digits) noexcept
+{
+    precision = std::clamp(digits, 0, MAX_PRECISION);
+}
+int Output::getPrecision() const noexcept
+{
+    return precision;
+}
+void Output::setElision(size_t limit) noexcept
+{
+    elision = limit;
+}
+size_t Output::getElision() const noexcept
+{
+    return elision;
+}
+void Output::setSink(std::string* target) noexcept
+{
+    sink = target;
+}
+std::string* Output::getSink() const noexcept
+{
+    return sink;
+}
+void Output::write(std::string_view text)
+{
+    if (sink != nullptr)
+    {
+        sink->append(text);
+        return;
+    }
+    std::fwrite(text.data(), 1, text.size(), stdout);
+}
+void Output::write(const Expression& value)
+{
+    scratch.clear();
+    value.print(scratch);
+    write(scratch);
+}
+void Output::writeLine(const Expression& value)
+{
+    scratch.clear();
+    switch (format)
+    {
+    case OutputFormat::Jsonl:
+        appendJson(scratch, value);
+        scratch += '\n';
+        break;
+    case OutputFormat::Binary:
+        appendRecord(scratch, value);
+        break;
+    case OutputFormat::Csv:
+        appendCsv(scratch, value);
+        scratch += '\n';
+        break;
+    default:
+        value.print(scratch);
+        scratch += '\n';
+        break;
+    }
+    write(scratch);
+}
+void Output::writeError(std::string_view type, std::string_view text)
+{
+    scratch.clear();
+    switch (format)
+    {
+    case OutputFormat::Jsonl:
+        scratch += "{\"type\":";
+        appendJsonString(scratch, type);
+        scratch += ",\"error\":";
+        appendJsonString(scratch, text);
+        scratch += "}\n";
+        break;
+    case OutputFormat::Binary:
+        appendTextRecord(scratch, RecordTag::Error, text);
+        break;
+    case OutputFormat::Csv:
+        scratch.append(type);
+        scratch += ',';
+        appendCsvText(scratch, text);
+        scratch += '\n';
+        break;
+    default:
+        scratch.append(text);
+        scratch += '\n';
+        break;
+    }
+    write(scratch);
+}
+void Output::writeMessage(std::string_view text)
+{
+    scratch.clear();
+    switch (format)
+    {
+    case OutputFormat::Jsonl:
+        scratch += "{\"type\":\"Print\",\"text\":";
+        appendJsonString(scratch, text);
+        scratch += "}\n";
+        break;
+    case OutputFormat::Binary:
+        appendTextRecord(scratch, RecordTag::Text, text);
+        break;
+    case OutputFormat::Csv:
+        appendCsvText(scratch, text);
+        scratch += '\n';
+        break;
+    default:
+        scratch.append(text);
+        scratch += '\n';
+        break;
+    }
+    write(scratch);
+}
+void Output::flush()
+{
+    std::fflush(stdout);
+}
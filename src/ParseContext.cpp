@@ -0,0 +1,42 @@
+#include <ParseContext.hpp>
+
+extern int yyparse(ParseContext* context);
+extern int yylex_init_extra(ParseContext* context, yyscan_t* scanner);
+extern int yylex_destroy(yyscan_t scanner);
+extern void yyrestart(FILE* input, yyscan_t scanner);
+extern void yyset_lineno(int line, yyscan_t scanner);
+
+ParseContext::ParseContext()
+    : scanner{nullptr}, result{nullptr}, pointers{}, statement_handler{}, error{},
+      num_column{0}, id{}, assing_id{}, take{true}
+{
+    yylex_init_extra(this, &scanner);
+}
+ParseContext::~ParseContext()
+{
+    yylex_destroy(scanner);
+}
+int ParseContext::parse(FILE* input)
+{
+    // Anything left in the scanner buffer belongs to the previous input
+    yyrestart(input, scanner);
+    yyset_lineno(1, scanner);
+    result = nullptr;
+    error.clear();
+    num_column = 0;
+    take = true;
+
+    int status = yyparse(this);
+
+    if (status != 0)
+    {
+        for (Expression* expr : pointers)
+        {
+            delete expr;
+        }
+        result = nullptr;
+    }
+    // On success every node is owned by the result
+    pointers.clear();
+    return status;
+}
@@ -0,0 +1,188 @@
+#include <Scheduler.hpp>
+#include <Expression.hpp>
+#include <Output.hpp>
+#include <ThreadPool.hpp>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    // A statement that reaches more names than this through the values of its names runs on its
+    // own, so long chains of assignments do not make the analysis quadratic
+    constexpr size_t MAX_TRACKED_READS = 256;
+
+    // Statements that write files, a later statement may load them
+    bool isExclusive(Expression* node)
+    {
+        auto ode = dynamic_cast<ODEFirstOrderInitialValues*>(node);
+        return dynamic_cast<SaveNpy*>(node) != nullptr || (ode != nullptr && ode->getOutput() != nullptr);
+    }
+}
+
+Scheduler::Scheduler(std::vector<Expression*> _statements) : statements{std::move(_statements)}, levels{}
+{
+    analyze();
+}
+void Scheduler::analyze()
+{
+    // A value keeps the names that were not bound when it was assigned, so a name may refer to any
+    // name that appeared in one of its assignments
+    std::unordered_map<std::string, std::unordered_set<std::string>> sources{};
+    std::unordered_map<std::string, size_t> writer{};
+    std::unordered_map<std::string, std::vector<size_t>> readers{};
+    std::vector<size_t> level(statements.size(), 0);
+    size_t first = 0;
+
+    for (size_t i = 0; i < statements.size(); ++i)
+    {
+        Expression* value = statements[i];
+        std::string target{};
+        if (auto assigment = dynamic_cast<Assigment*>(value))
+        {
+            if (auto name = dynamic_cast<Name*>(assigment->getLeftExpression()))
+            {
+                target = name->getName();
+            }
+            value = assigment->getRightExpression();
+        }
+
+        std::unordered_set<std::string> names{};
+        bool exclusive = false;
+        forEachNode(value, [&](Expression* node)
+        {
+            if (auto name = dynamic_cast<Name*>(node))
+            {
+                names.insert(name->getName());
+            }
+            exclusive = exclusive || isExclusive(node);
+            return true;
+        });
+
+        std::unordered_set<std::string> reads = names;
+        std::vector<std::string> pending(names.begin(), names.end());
+        while (!pending.empty() && !exclusive)
+        {
+            auto found = sources.find(pending.back());
+            pending.pop_back();
+            if (found == sources.end())
+            {
+                continue;
+            }
+            for (const auto& source : found->second)
+            {
+                if (reads.insert(source).second)
+                {
+                    pending.push_back(source);
+                }
+            }
+            exclusive = reads.size() > MAX_TRACKED_READS;
+        }
+
+        size_t l = first;
+        if (exclusive)
+        {
+            l = levels.size();
+            first = l + 1;
+        }
+        else
+        {
+            for (const auto& name : reads)
+            {
+                if (auto w = writer.find(name); w != writer.end())
+                {
+                    l = std::max(l, level[w->second] + 1);
+                }
+            }
+            // The assignments of a level are applied after every statement of the level ran, in
+            // program order, so an assignment can share the level of the reads it has to wait for
+            if (!target.empty())
+            {
+                if (auto w = writer.find(target); w != writer.end())
+                {
+                    l = std::max(l, level[w->second]);
+                }
+                for (size_t r : readers[target])
+                {
+                    l = std::max(l, level[r]);
+                }
+            }
+        }
+        if (l == levels.size())
+        {
+            levels.emplace_back();
+        }
+        levels[l].push_back(i);
+        level[i] = l;
+
+        for (const auto& name : reads)
+        {
+            readers[name].push_back(i);
+        }
+        if (!target.empty())
+        {
+            sources[target].insert(names.begin(), names.end());
+            readers[target].clear();
+            writer[target] = i;
+        }
+    }
+}
+Expression* Scheduler::run(Environment& env) const
+{
+    auto& output = Output::instance();
+    std::string* sink = output.getSink();
+    std::vector<Expression*> results(statements.size(), nullptr);
+    std::vector<Expression*> values(statements.size(), nullptr);
+    std::vector<std::string> texts(statements.size());
+    size_t written = 0;
+
+    auto evaluate = [&](size_t i)
+    {
+        // Only the first statement that has not written yet can write directly, the others
+        // keep their output until the statements before them are done
+        std::string* previous = output.getSink();
+        output.setSink((i == written) ? sink : &texts[i]);
+        if (auto assigment = dynamic_cast<Assigment*>(statements[i]))
+        {
+            Expression* error = assigment->evalValue(env, values[i]);
+            results[i] = (error != nullptr) ? error : new Unit();
+        }
+        else
+        {
+            results[i] = statements[i]->eval(env);
+        }
+        output.setSink(previous);
+    };
+
+    for (const auto& level : levels)
+    {
+        if (level.size() == 1)
+        {
+            evaluate(level[0]);
+        }
+        else
+        {
+            // Nothing changes the variables while the statements of a level run
+            ThreadPool::instance().parallelFor(level.size(), [&](size_t k) { evaluate(level[k]); });
+        }
+        for (size_t i : level)
+        {
+            if (values[i] != nullptr)
+            {
+                dynamic_cast<Assigment*>(statements[i])->bind(env, values[i]);
+            }
+        }
+        while (written < statements.size() && results[written] != nullptr)
+        {
+            output.write(texts[written]);
+            std::string{}.swap(texts[written]);
+            ++written;
+        }
+    }
+
+    ExpressionList* exp_list = new ExpressionList();
+    for (auto result : results)
+    {
+        exp_list->addExpressionBack(result);
+    }
+    return exp_list;
+}
@@ -0,0 +1,396 @@
+#include <Server.hpp>
+#include <Interpreter.hpp>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    // Requests bigger than this in total are rejected before anything is allocated
+    constexpr size_t MAX_REQUEST_BYTES = size_t(1) << 30;
+
+    volatile std::sig_atomic_t stop_requested = 0;
+
+    void requestStop(int)
+    {
+        stop_requested = 1;
+    }
+
+    template <typename T>
+    void appendRaw(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    bool readAll(int fd, void* data, size_t size)
+    {
+        char* bytes = static_cast<char*>(data);
+        while (size > 0)
+        {
+            ssize_t count = recv(fd, bytes, size, 0);
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (count <= 0)
+            {
+                return false;
+            }
+            bytes += count;
+            size -= count;
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool readRaw(int fd, T& value)
+    {
+        return readAll(fd, &value, sizeof(value));
+    }
+
+    // Takes size bytes from what is left of the request, false when it does not fit
+    bool reserve(size_t& budget, size_t size)
+    {
+        if (size > budget)
+        {
+            return false;
+        }
+        budget -= size;
+        return true;
+    }
+
+    bool readString(int fd, std::string& text, size_t size, size_t& budget)
+    {
+        if (!reserve(budget, size))
+        {
+            return false;
+        }
+        text.resize(size);
+        return readAll(fd, text.data(), size);
+    }
+
+    ServerResponse evaluateRequest(Interpreter& interpreter, const ServerRequest& request)
+    {
+        ServerResponse response{ServerStatus::Ok, {}};
+        interpreter.reset();
+        for (const auto& binding : request.bindings)
+        {
+            if (binding.shape.empty())
+            {
+                interpreter.setNumber(binding.name, binding.values[0]);
+            }
+            else if (binding.shape.size() == 1)
+            {
+                interpreter.setVector(binding.name, binding.values.data(), binding.shape[0]);
+            }
+            else
+            {
+                interpreter.setMatrix(binding.name, binding.values.data(), binding.shape[0], binding.shape[1]);
+            }
+        }
+        try
+        {
+            if (!interpreter.evaluate(request.script, response.output))
+            {
+                response.status = ServerStatus::SyntaxError;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            response.status = ServerStatus::Failed;
+            response.output = e.what();
+        }
+        return response;
+    }
+}
+
+void encodeRequest(const ServerRequest& request, std::string& out)
+{
+    appendRaw(out, static_cast<uint32_t>(request.script.size()));
+    appendRaw(out, static_cast<uint32_t>(request.bindings.size()));
+    out += request.script;
+    for (const auto& binding : request.bindings)
+    {
+        appendRaw(out, static_cast<uint32_t>(binding.name.size()));
+        out += binding.name;
+        appendRaw(out, static_cast<uint8_t>(binding.shape.size()));
+        for (size_t dimension : binding.shape)
+        {
+            appendRaw(out, static_cast<uint64_t>(dimension));
+        }
+        out.append(reinterpret_cast<const char*>(binding.values.data()), binding.values.size() * sizeof(double));
+    }
+}
+void encodeResponse(const ServerResponse& response, std::string& out)
+{
+    appendRaw(out, static_cast<uint32_t>(response.status));
+    appendRaw(out, static_cast<uint32_t>(response.output.size()));
+    out += response.output;
+}
+bool readRequest(int fd, ServerRequest& request)
+{
+    size_t budget = MAX_REQUEST_BYTES;
+    uint32_t scriptSize = 0;
+    uint32_t bindingCount = 0;
+    if (!readRaw(fd, scriptSize) || !readRaw(fd, bindingCount) || !readString(fd, request.script, scriptSize, budget))
+    {
+        return false;
+    }
+    // Every binding takes its memory from the same budget as its bytes
+    if (bindingCount > budget / sizeof(ServerBinding))
+    {
+        return false;
+    }
+    request.bindings.clear();
+    request.bindings.reserve(bindingCount);
+    budget -= bindingCount * sizeof(ServerBinding);
+    for (uint32_t i = 0; i < bindingCount; ++i)
+    {
+        ServerBinding binding{};
+        uint32_t nameSize = 0;
+        uint8_t dimensions = 0;
+        if (!readRaw(fd, nameSize) || !readString(fd, binding.name, nameSize, budget) || !readRaw(fd, dimensions) || dimensions > 2)
+        {
+            return false;
+        }
+        size_t count = 1;
+        for (uint8_t d = 0; d < dimensions; ++d)
+        {
+            uint64_t dimension = 0;
+            if (!readRaw(fd, dimension) || (dimension != 0 && count > budget / sizeof(double) / dimension))
+            {
+                return false;
+            }
+            binding.shape.push_back(dimension);
+            count *= dimension;
+        }
+        if (!reserve(budget, count * sizeof(double)))
+        {
+            return false;
+        }
+        binding.values.resize(count);
+        if (!readAll(fd, binding.values.data(), count * sizeof(double)))
+        {
+            return false;
+        }
+        request.bindings.push_back(std::move(binding));
+    }
+    return true;
+}
+bool readResponse(int fd, ServerResponse& response)
+{
+    uint32_t status = 0;
+    uint32_t outputSize = 0;
+    size_t budget = MAX_REQUEST_BYTES;
+    if (!readRaw(fd, status) || !readRaw(fd, outputSize) || !readString(fd, response.output, outputSize, budget))
+    {
+        return false;
+    }
+    response.status = static_cast<ServerStatus>(status);
+    return true;
+}
+bool writeAll(int fd, std::string_view data)
+{
+    while (!data.empty())
+    {
+        ssize_t count = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+        data.remove_prefix(count);
+    }
+    return true;
+}
+
+Server::Server(std::string _path, size_t _workers)
+    : path{std::move(_path)}, workerCount{std::max<size_t>(_workers, 1)}, listener{-1}, wakeup{-1, -1}, workers{},
+      ready{}, returned{}, active{}, mutex{}, condition{}, stopping{false}
+{
+}
+Server::~Server()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        // Wakes up workers waiting for the rest of a request
+        for (int fd : active)
+        {
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+    condition.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    while (!ready.empty())
+    {
+        close(ready.front());
+        ready.pop();
+    }
+    for (int fd : returned)
+    {
+        close(fd);
+    }
+    for (int fd : wakeup)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+    if (listener >= 0)
+    {
+        close(listener);
+        unlink(path.c_str());
+    }
+}
+void Server::workerLoop()
+{
+    Interpreter interpreter;
+    ServerRequest request{};
+    std::string frame{};
+    while (true)
+    {
+        int fd = -1;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !ready.empty(); });
+            if (stopping)
+            {
+                return;
+            }
+            fd = ready.front();
+            ready.pop();
+            active.insert(fd);
+        }
+        bool open = readRequest(fd, request);
+        if (open)
+        {
+            frame.clear();
+            encodeResponse(evaluateRequest(interpreter, request), frame);
+            open = writeAll(fd, frame);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            active.erase(fd);
+            if (open)
+            {
+                returned.push_back(fd);
+            }
+        }
+        if (!open)
+        {
+            close(fd);
+            continue;
+        }
+        char byte = 0;
+        while (write(wakeup[1], &byte, 1) < 0 && errno == EINTR)
+        {
+        }
+    }
+}
+int Server::run()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 128) != 0)
+    {
+        std::cerr << "Could not listen on " << path << ": " << std::strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (pipe(wakeup) != 0)
+    {
+        std::cerr << "Could not create a pipe: " << std::strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+    fcntl(wakeup[0], F_SETFL, O_NONBLOCK);
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+
+    // The listener, the wakeup pipe, then the connections waiting for their next request
+    std::vector<pollfd> waiting{{listener, POLLIN, 0}, {wakeup[0], POLLIN, 0}};
+    while (!stop_requested)
+    {
+        // Wakes up regularly to notice a stop request
+        if (poll(waiting.data(), waiting.size(), 200) <= 0)
+        {
+            continue;
+        }
+        std::vector<int> readable{};
+        for (size_t i = 2; i < waiting.size();)
+        {
+            // A hang up also makes the connection readable, the worker then closes it
+            if (waiting[i].revents != 0)
+            {
+                readable.push_back(waiting[i].fd);
+                waiting[i] = waiting.back();
+                waiting.pop_back();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        if (waiting[0].revents & POLLIN)
+        {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd >= 0)
+            {
+                waiting.push_back({fd, POLLIN, 0});
+            }
+        }
+        if (waiting[1].revents & POLLIN)
+        {
+            char bytes[64];
+            while (read(wakeup[0], bytes, sizeof(bytes)) > 0)
+            {
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int fd : returned)
+            {
+                waiting.push_back({fd, POLLIN, 0});
+            }
+            returned.clear();
+            for (int fd : readable)
+            {
+                ready.push(fd);
+            }
+        }
+        for (size_t i = 0; i < readable.size(); ++i)
+        {
+            condition.notify_one();
+        }
+    }
+    for (size_t i = 2; i < waiting.size(); ++i)
+    {
+        close(waiting[i].fd);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+#include <ThreadPool.hpp>
+
+ThreadPool::ThreadPool(size_t threads) : workers{}, tasks{}, mutex{}, condition{}, stopping{false}
+{
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+    for (size_t i = 0; i < threads; ++i)
+    {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+void ThreadPool::workerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty())
+            {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    condition.notify_one();
+}
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (count == 1 || workers.size() == 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    struct Shared
+    {
+        std::atomic<size_t> next{0};
+        size_t count{0};
+        const std::function<void(size_t)>* task{nullptr};
+        std::mutex mutex{};
+        std::condition_variable done{};
+        size_t running{0};
+    };
+    auto shared = std::make_shared<Shared>();
+    shared->count = count;
+    shared->task = &task;
+
+    auto work = [](Shared& state)
+    {
+        for (size_t i = state.next++; i < state.count; i = state.next++)
+        {
+            (*state.task)(i);
+        }
+    };
+
+    size_t helpers = std::min(workers.size(), count - 1);
+    for (size_t h = 0; h < helpers; ++h)
+    {
+        submit([shared, work]
+        {
+            {
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                if (shared->next >= shared->count)
+                {
+                    return;
+                }
+                ++shared->running;
+            }
+            work(*shared);
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            --shared->running;
+            shared->done.notify_all();
+        });
+    }
+
+    work(*shared);
+
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->done.wait(lock, [&shared] { return shared->running == 0; });
+}
+size_t ThreadPool::size() const noexcept
+{
+    return workers.size();
+}
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool{};
+    return pool;
+}
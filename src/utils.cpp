@@ -1,5 +1,13 @@
 #include <utils.hpp>
 #include <Expression.hpp>
+#include <charconv>
+#include <tuple>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 std::string dataTypeToString(DataType d)
 {
@@ -15,108 +23,786 @@ std::string dataTypeToString(DataType d)
         return "Number";
     case DataType::Name:
         return "Name";
+    case DataType::String:
+        return "String";
+    case DataType::Spline:
+        return "Spline";
+    case DataType::Points:
+        return "Points";
     default:
         return "DataType Undefined";
     }
 }
 
-bool containsName(Expression* expr, const std::string& varName, Environment& env) noexcept
+void forEachNode(Expression* expr, const std::function<bool(Expression*)>& visit)
+{
+    // Numbers are most of the nodes of large literals and have nothing inside
+    if (expr == nullptr || !visit(expr) || dynamic_cast<Number*>(expr) != nullptr)
+    {
+        return;
+    }
+
+    auto visitAll = [&visit](auto... children)
+    {
+        (forEachNode(children, visit), ...);
+    };
+    auto visitTuple = [&visitAll](const auto& children)
+    {
+        std::apply(visitAll, children);
+    };
+
+    if (auto binary = dynamic_cast<BinaryExpression*>(expr))
+    {
+        visitAll(binary->getLeftExpression(), binary->getRightExpression());
+    }
+    else if (auto unary = dynamic_cast<UnaryExpression*>(expr))
+    {
+        visitAll(unary->getExpression());
+    }
+    else if (auto vec = dynamic_cast<Vector*>(expr))
+    {
+        for (auto e : vec->getVectorExpression())
+        {
+            forEachNode(e, visit);
+        }
+    }
+    else if (auto mat = dynamic_cast<Matrix*>(expr); mat != nullptr && !mat->isDense())
+    {
+        for (auto e : mat->getMatrixExpression())
+        {
+            forEachNode(e, visit);
+        }
+    }
+    else if (auto pair = dynamic_cast<Pair*>(expr))
+    {
+        visitAll(pair->getFirst(), pair->getSecond());
+    }
+    else if (auto inverse = dynamic_cast<InverseMatrix*>(expr))
+    {
+        visitAll(inverse->getMatrix());
+    }
+    else if (auto lu = dynamic_cast<MatrixLU*>(expr))
+    {
+        visitAll(lu->getMatrix());
+    }
+    else if (auto tridiagonal = dynamic_cast<TridiagonalMatrix*>(expr))
+    {
+        visitAll(tridiagonal->getMatrix());
+    }
+    else if (auto eigenvalues = dynamic_cast<RealEigenvalues*>(expr))
+    {
+        visitAll(eigenvalues->getMatrix());
+    }
+    else if (auto determinant = dynamic_cast<Determinant*>(expr))
+    {
+        visitAll(determinant->getMatrix());
+    }
+    else if (auto integral = dynamic_cast<Integral*>(expr))
+    {
+        visitTuple(integral->getExpressions());
+    }
+    else if (auto points = dynamic_cast<CreatePoints*>(expr))
+    {
+        visitAll(points->getExpression());
+    }
+    else if (auto csv = dynamic_cast<LoadCsv*>(expr))
+    {
+        visitTuple(csv->getExpressions());
+    }
+    else if (auto npy = dynamic_cast<LoadNpy*>(expr))
+    {
+        visitAll(npy->getExpression());
+    }
+    else if (auto npy = dynamic_cast<SaveNpy*>(expr))
+    {
+        visitTuple(npy->getExpressions());
+    }
+    else if (auto interp = dynamic_cast<Interpolate*>(expr))
+    {
+        visitTuple(interp->getExpressions());
+    }
+    else if (auto spline = dynamic_cast<CreateSpline*>(expr))
+    {
+        visitTuple(spline->getExpressions());
+    }
+    else if (auto ode = dynamic_cast<ODEFirstOrderInitialValues*>(expr))
+    {
+        visitTuple(ode->getExpressions());
+    }
+    else if (auto root = dynamic_cast<FindRootBisection*>(expr))
+    {
+        visitTuple(root->getExpressions());
+    }
+    else if (auto roots = dynamic_cast<AllRoots*>(expr))
+    {
+        visitTuple(roots->getExpressions());
+    }
+    else if (auto root = dynamic_cast<FindRoot*>(expr))
+    {
+        visitTuple(root->getExpressions());
+    }
+    else if (auto derivative = dynamic_cast<Derivative*>(expr))
+    {
+        visitTuple(derivative->getExpressions());
+    }
+    else if (auto binding = dynamic_cast<Binding*>(expr))
+    {
+        visitAll(binding->getValue());
+    }
+    else if (auto display = dynamic_cast<Display*>(expr))
+    {
+        visitAll(display->getExpression());
+    }
+    else if (auto list = dynamic_cast<ExpressionList*>(expr))
+    {
+        for (auto e : list->getVectorExpression())
+        {
+            forEachNode(e, visit);
+        }
+    }
+}
+
+bool containsName(Expression* expr, const std::string& varName, Environment&) noexcept
+{
+    bool found = false;
+    forEachNode(expr, [&](Expression* node)
+    {
+        if (auto name = dynamic_cast<Name*>(node))
+        {
+            found = found || name->getName() == varName;
+            return false;
+        }
+        // The matrix functions never give a value that refers to a name, so `A = INVERSE(A)` is allowed
+        return !found && dynamic_cast<InverseMatrix*>(node) == nullptr && dynamic_cast<MatrixLU*>(node) == nullptr &&
+               dynamic_cast<TridiagonalMatrix*>(node) == nullptr && dynamic_cast<RealEigenvalues*>(node) == nullptr &&
+               dynamic_cast<Determinant*>(node) == nullptr && dynamic_cast<Display*>(node) == nullptr;
+    });
+    return found;
+}
+
+Expression* evalDual(Expression* expr, const std::string& varName, double at, Dual& result) noexcept
 {
     if (expr == nullptr)
     {
-        return false;
+        return new Invalid("Cannot differentiate an empty expression");
+    }
+
+    // An operand that already failed keeps its own message
+    if (auto invalid = dynamic_cast<Invalid*>(expr))
+    {
+        return new Invalid(invalid->getMessage());
+    }
+    if (auto impossible = dynamic_cast<Impossible*>(expr))
+    {
+        return new Impossible(impossible->getMessage());
+    }
+
+    if (auto num = dynamic_cast<Number*>(expr))
+    {
+        result = {num->getNumber(), 0.0};
+        return nullptr;
+    }
+
+    if (dynamic_cast<PI*>(expr))
+    {
+        result = {M_PI, 0.0};
+        return nullptr;
+    }
+
+    if (dynamic_cast<EULER*>(expr))
+    {
+        result = {M_E, 0.0};
+        return nullptr;
     }
 
     if (auto name = dynamic_cast<Name*>(expr))
     {
-        return name->getName() == varName;
+        if (name->getName() != varName)
+        {
+            return new Invalid("Cannot differentiate with unbound variable '" + name->getName() + "'");
+        }
+        result = {at, 1.0};
+        return nullptr;
     }
 
     if (auto binary = dynamic_cast<BinaryExpression*>(expr))
     {
-        return containsName(binary->getLeftExpression(), varName, env) || containsName(binary->getRightExpression(), varName, env);
+        Dual u{}, v{};
+        if (auto error = evalDual(binary->getLeftExpression(), varName, at, u))
+        {
+            return error;
+        }
+        if (auto error = evalDual(binary->getRightExpression(), varName, at, v))
+        {
+            return error;
+        }
+
+        if (dynamic_cast<Addition*>(expr))
+        {
+            result = {u.value + v.value, u.derivative + v.derivative};
+            return nullptr;
+        }
+        if (dynamic_cast<Substraction*>(expr))
+        {
+            result = {u.value - v.value, u.derivative - v.derivative};
+            return nullptr;
+        }
+        if (dynamic_cast<Multiplication*>(expr))
+        {
+            result = {u.value * v.value, u.derivative * v.value + u.value * v.derivative};
+            return nullptr;
+        }
+        if (dynamic_cast<Division*>(expr))
+        {
+            if (std::abs(v.value) <= 0.00000001)
+            {
+                return new Impossible("Division by 0");
+            }
+            result = {u.value / v.value, (u.derivative * v.value - u.value * v.derivative) / (v.value * v.value)};
+            return nullptr;
+        }
+        if (dynamic_cast<Power*>(expr))
+        {
+            if (v.value <= 0 && std::abs(u.value) <= 0.00000001)
+            {
+                return new Impossible("Undefined operation for 0 to power of non-positive number");
+            }
+            double value = std::pow(u.value, v.value);
+            if (v.derivative == 0.0)
+            {
+                result = {value, v.value * std::pow(u.value, v.value - 1) * u.derivative};
+                return nullptr;
+            }
+            if (u.value <= 0)
+            {
+                return new Impossible("Derivative of a variable exponent requires a positive base");
+            }
+            result = {value, value * (v.derivative * std::log(u.value) + v.value * u.derivative / u.value)};
+            return nullptr;
+        }
+        if (dynamic_cast<Logarithm*>(expr))
+        {
+            if (v.value <= 0)
+            {
+                return new Impossible("Logarithm of non-positive number (" + std::to_string(v.value) + ")");
+            }
+            if (u.value <= 0 || u.value == 1)
+            {
+                return new Impossible((u.value == 1) ? "Logarithm base = 1" : "Logarithm base of non-positive number (" + std::to_string(u.value) + ")");
+            }
+            double lnBase = std::log(u.value);
+            double lnNumber = std::log(v.value);
+            double derivative = (v.derivative / v.value * lnBase - lnNumber * u.derivative / u.value) / (lnBase * lnBase);
+            result = {lnNumber / lnBase, derivative};
+            return nullptr;
+        }
+        if (dynamic_cast<Root*>(expr))
+        {
+            // The index is an integer, a term that depends on the variable has no derivative
+            if (u.derivative != 0)
+            {
+                return new Invalid("Cannot differentiate " + expr->toString());
+            }
+            int index = u.value;
+            if (index == 0)
+            {
+                return new Impossible("Root with index 0");
+            }
+            if (v.value < 0 && index % 2 == 0)
+            {
+                return new Impossible("Negative root with even index (root: " + std::to_string(v.value) + ") (index: " + std::to_string(index) + ")");
+            }
+            if (std::abs(v.value) <= 0.00000001)
+            {
+                return new Impossible("Root is not differentiable at 0");
+            }
+            double value = (v.value < 0) ? -std::pow(-v.value, 1.0 / index) : std::pow(v.value, 1.0 / index);
+            result = {value, value * v.derivative / (index * v.value)};
+            return nullptr;
+        }
+        return new Invalid("Cannot differentiate " + expr->toString());
     }
 
     if (auto unary = dynamic_cast<UnaryExpression*>(expr))
     {
-        return containsName(unary->getExpression(), varName, env);
+        Dual u{};
+        if (auto error = evalDual(unary->getExpression(), varName, at, u))
+        {
+            return error;
+        }
+
+        if (dynamic_cast<Negation*>(expr))
+        {
+            result = {-u.value, -u.derivative};
+            return nullptr;
+        }
+        if (dynamic_cast<NaturalLogarithm*>(expr))
+        {
+            if (u.value <= 0)
+            {
+                return new Impossible("Logarithm of non-positive number (" + std::to_string(u.value) + ")");
+            }
+            result = {std::log(u.value), u.derivative / u.value};
+            return nullptr;
+        }
+        if (dynamic_cast<SquareRoot*>(expr))
+        {
+            if (u.value <= 0)
+            {
+                return new Impossible("Square root is only differentiable for positive numbers (root: " + std::to_string(u.value) + ")");
+            }
+            double value = std::sqrt(u.value);
+            result = {value, u.derivative / (2 * value)};
+            return nullptr;
+        }
+        if (dynamic_cast<Sine*>(expr))
+        {
+            result = {std::sin(u.value), std::cos(u.value) * u.derivative};
+            return nullptr;
+        }
+        if (dynamic_cast<Cosine*>(expr))
+        {
+            result = {std::cos(u.value), -std::sin(u.value) * u.derivative};
+            return nullptr;
+        }
+        if (dynamic_cast<Tangent*>(expr))
+        {
+            double cosine = std::cos(u.value);
+            if (std::abs(cosine) <= 0.00000001)
+            {
+                return new Impossible("Tangent undefined where cos(x)=0 (x = " + std::to_string(u.value) + ")");
+            }
+            result = {std::tan(u.value), u.derivative / (cosine * cosine)};
+            return nullptr;
+        }
+        if (dynamic_cast<Cotangent*>(expr))
+        {
+            double sine = std::sin(u.value);
+            if (std::abs(sine) <= 0.00000001)
+            {
+                return new Impossible("Cotangent undefined where sin(x)=0 (x = " + std::to_string(u.value) + ")");
+            }
+            result = {1 / std::tan(u.value), -u.derivative / (sine * sine)};
+            return nullptr;
+        }
+        return new Invalid("Cannot differentiate " + expr->toString());
+    }
+
+    return new Invalid("Cannot differentiate " + expr->toString());
+}
+
+PointEvaluator::PointEvaluator(Expression* _function, const std::string& variable) : function{_function}, env{}
+{
+    env.push_front(std::make_pair(variable, new Number(0.0)));
+}
+PointEvaluator::~PointEvaluator()
+{
+    for (auto& t : env)
+    {
+        if (t.second != nullptr)
+        {
+            t.second->destroy();
+            delete t.second;
+            t.second = nullptr;
+        }
     }
+}
+Expression* PointEvaluator::operator()(double x, double& y)
+{
+    auto& slot = env.front();
+    slot.second->destroy();
+    delete slot.second;
+    slot.second = new Number(x);
 
-    if (auto vec = dynamic_cast<Vector*>(expr))
+    auto ev = function->eval(env);
+    auto num = dynamic_cast<Number*>(ev);
+    if (num == nullptr)
     {
-        for (auto e : vec->getVectorExpression())
+        ev->destroy();
+        delete ev;
+        return new Invalid("Expected that elements in the function evaluate to numeric values");
+    }
+    y = num->getNumber();
+    ev->destroy();
+    delete ev;
+    return nullptr;
+}
+
+TrajectoryWriter::TrajectoryWriter(const std::string& _path, const std::vector<std::string>& columns) : path{_path}, file{std::fopen(_path.c_str(), "wb")}, binary{false}, failed{false}, buffer{}
+{
+    binary = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+    buffer.reserve(1 << 16);
+    if (file != nullptr && !binary)
+    {
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            buffer += (i == 0) ? "" : ",";
+            buffer += columns[i];
+        }
+        buffer += "\n";
+    }
+}
+TrajectoryWriter::~TrajectoryWriter()
+{
+    close();
+}
+bool TrajectoryWriter::isOpen() const noexcept
+{
+    return file != nullptr;
+}
+const std::string& TrajectoryWriter::getPath() const noexcept
+{
+    return path;
+}
+void TrajectoryWriter::flush()
+{
+    // The first short write is kept, the rest of the trajectory is dropped
+    failed = failed || std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size();
+    buffer.clear();
+}
+bool TrajectoryWriter::close()
+{
+    if (file == nullptr)
+    {
+        return !failed;
+    }
+    flush();
+    failed = (std::fclose(file) != 0) || failed;
+    file = nullptr;
+    return !failed;
+}
+void TrajectoryWriter::write(double t, const double* x, size_t n)
+{
+    if (file == nullptr || failed)
+    {
+        return;
+    }
+    if (binary)
+    {
+        buffer.append(reinterpret_cast<const char*>(&t), sizeof(double));
+        buffer.append(reinterpret_cast<const char*>(x), n * sizeof(double));
+    }
+    else
+    {
+        char number[32];
+        auto res = std::to_chars(number, number + sizeof(number), t);
+        buffer.append(number, res.ptr);
+        for (size_t i = 0; i < n; ++i)
+        {
+            res = std::to_chars(number, number + sizeof(number), x[i]);
+            buffer += ',';
+            buffer.append(number, res.ptr);
+        }
+        buffer += '\n';
+    }
+    if (buffer.size() >= (1 << 16))
+    {
+        flush();
+    }
+}
+
+Expression* readCsv(const std::string& path, std::vector<double>& values, size_t& rows, size_t& columns) noexcept
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return new Invalid("Could not open file '" + path + "'");
+    }
+    rows = 0;
+    columns = 0;
+    size_t lineNumber = 0;
+    bool headerAllowed = true;
+    std::string error{};
+
+    auto isBlank = [](char c) { return c == ' ' || c == '\t'; };
+    auto parseLine = [&](const char* p, const char* last) -> bool
+    {
+        ++lineNumber;
+        if (last > p && last[-1] == '\r')
+        {
+            --last;
+        }
+        while (p < last && isBlank(*p))
+        {
+            ++p;
+        }
+        if (p == last)
+        {
+            return true;
+        }
+        size_t start = values.size();
+        size_t count = 0;
+        while (true)
         {
-            if (containsName(e, varName, env))
+            while (p < last && isBlank(*p))
             {
-                return true;
+                ++p;
             }
+            // from_chars does not accept a leading '+'
+            if (p < last && *p == '+')
+            {
+                ++p;
+            }
+            double value = 0.0;
+            auto [next, ec] = std::from_chars(p, last, value);
+            p = next;
+            while (ec == std::errc{} && p < last && isBlank(*p))
+            {
+                ++p;
+            }
+            if (ec != std::errc{} || (p < last && *p != ','))
+            {
+                values.resize(start);
+                if (headerAllowed)
+                {
+                    headerAllowed = false;
+                    return true;
+                }
+                error = "Could not read a number at line " + std::to_string(lineNumber) + " of '" + path + "'";
+                return false;
+            }
+            values.push_back(value);
+            ++count;
+            if (p == last)
+            {
+                break;
+            }
+            ++p;
         }
-    }
+        headerAllowed = false;
+        if (columns == 0)
+        {
+            columns = count;
+        }
+        else if (count != columns)
+        {
+            error = "Inconsistent row sizes at line " + std::to_string(lineNumber) + " of '" + path + "'";
+            return false;
+        }
+        ++rows;
+        return true;
+    };
 
-    if (auto mat = dynamic_cast<Matrix*>(expr))
+    // Lines are parsed in place, an unfinished line is carried to the front of the next chunk
+    std::vector<char> buffer(1 << 20);
+    size_t pending = 0;
+    bool ok = true;
+    while (ok)
     {
-        for (auto e : mat->getMatrixExpression())
+        size_t read = std::fread(buffer.data() + pending, 1, buffer.size() - pending, file);
+        if (read == 0)
+        {
+            if (pending > 0)
+            {
+                ok = parseLine(buffer.data(), buffer.data() + pending);
+            }
+            break;
+        }
+        const char* end = buffer.data() + pending + read;
+        const char* lineStart = buffer.data();
+        while (ok)
         {
-            if (containsName(e, varName, env))
+            auto newline = static_cast<const char*>(std::memchr(lineStart, '\n', end - lineStart));
+            if (newline == nullptr)
             {
-                return true;
+                break;
             }
+            ok = parseLine(lineStart, newline);
+            lineStart = newline + 1;
+        }
+        pending = end - lineStart;
+        std::memmove(buffer.data(), lineStart, pending);
+        if (pending == buffer.size())
+        {
+            buffer.resize(buffer.size() * 2);
         }
     }
+    std::fclose(file);
 
-    if (auto pair = dynamic_cast<Pair*>(expr))
+    if (!ok)
     {
-        return containsName(pair->getFirst(), varName, env) || containsName(pair->getSecond(), varName, env);
+        return new Invalid(error);
     }
+    if (rows == 0)
+    {
+        return new Invalid("No numeric rows in '" + path + "'");
+    }
+    return nullptr;
+}
 
-    if (auto func = dynamic_cast<Function*>(expr))
+namespace
+{
+    const char NPY_MAGIC[] = "\x93NUMPY";
+    constexpr size_t NPY_MAGIC_SIZE = 6;
+
+    bool littleEndianHost() noexcept
     {
-        return containsName(func->getExpression(), varName, env);
+        uint16_t probe = 1;
+        return *reinterpret_cast<const unsigned char*>(&probe) == 1;
     }
 
-    if (auto integral = dynamic_cast<Integral*>(expr))
+    // Value of a key in the header dictionary, up to the next top level comma or closing brace
+    std::string_view npyField(std::string_view header, std::string_view key) noexcept
     {
-        auto exprs = integral->getExpressions();
-        return containsName(std::get<0>(exprs), varName, env) ||
-               containsName(std::get<1>(exprs), varName, env) ||
-               containsName(std::get<2>(exprs), varName, env);
+        size_t position = header.find("'" + std::string(key) + "'");
+        if (position == std::string_view::npos)
+        {
+            return {};
+        }
+        position = header.find(':', position);
+        if (position == std::string_view::npos)
+        {
+            return {};
+        }
+        size_t end = position + 1;
+        int depth = 0;
+        while (end < header.size() && (depth > 0 || (header[end] != ',' && header[end] != '}')))
+        {
+            depth += (header[end] == '(') - (header[end] == ')');
+            ++end;
+        }
+        auto value = header.substr(position + 1, end - position - 1);
+        while (!value.empty() && value.front() == ' ')
+        {
+            value.remove_prefix(1);
+        }
+        while (!value.empty() && value.back() == ' ')
+        {
+            value.remove_suffix(1);
+        }
+        return value;
     }
+}
 
-    if (auto interp = dynamic_cast<Interpolate*>(expr))
+Expression* mapNpy(const std::string& path, std::shared_ptr<const double>& data, size_t& rows, size_t& columns) noexcept
+{
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return new Invalid("Could not open file '" + path + "'");
+    }
+    struct stat info{};
+    if (::fstat(descriptor, &info) != 0 || info.st_size < 10)
+    {
+        ::close(descriptor);
+        return new Invalid("'" + path + "' is not a .npy file");
+    }
+    size_t length = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED)
     {
-        auto exprs = interp->getExpressions();
-        return containsName(std::get<0>(exprs), varName, env) ||
-               containsName(std::get<1>(exprs), varName, env);
+        return new Invalid("Could not map file '" + path + "'");
     }
+    auto base = static_cast<const char*>(mapping);
+    auto fail = [&](const std::string& message) -> Expression*
+    {
+        ::munmap(mapping, length);
+        return new Invalid(message);
+    };
 
-    if (auto ode = dynamic_cast<ODEFirstOrderInitialValues*>(expr))
+    if (std::memcmp(base, NPY_MAGIC, NPY_MAGIC_SIZE) != 0)
+    {
+        return fail("'" + path + "' is not a .npy file");
+    }
+    // Version 1 stores the header length in two bytes, versions 2 and 3 in four
+    unsigned char major = base[6];
+    size_t prefix = (major == 1) ? 10 : 12;
+    if (major < 1 || major > 3 || length < prefix)
+    {
+        return fail("Unsupported .npy version in '" + path + "'");
+    }
+    auto byte = [&](size_t i) { return static_cast<size_t>(static_cast<unsigned char>(base[i])); };
+    size_t headerLength = (major == 1) ? (byte(8) | byte(9) << 8) : (byte(8) | byte(9) << 8 | byte(10) << 16 | byte(11) << 24);
+    if (length < prefix + headerLength)
     {
-        auto exprs = ode->getExpressions();
-        return containsName(std::get<0>(exprs), varName, env) ||
-               containsName(std::get<1>(exprs), varName, env) ||
-               containsName(std::get<2>(exprs), varName, env) ||
-               containsName(std::get<3>(exprs), varName, env);
+        return fail("'" + path + "' is not a .npy file");
     }
+    std::string_view header(base + prefix, headerLength);
 
-    if (auto root = dynamic_cast<FindRootBisection*>(expr))
+    auto descr = npyField(header, "descr");
+    if ((descr != "'<f8'" && descr != "'=f8'") || !littleEndianHost())
+    {
+        return fail("Only float64 .npy arrays are supported, '" + path + "' has " + std::string(descr));
+    }
+    if (npyField(header, "fortran_order") != "False")
     {
-        auto exprs = root->getExpressions();
-        return containsName(std::get<0>(exprs), varName, env) ||
-               containsName(std::get<1>(exprs), varName, env) ||
-               containsName(std::get<2>(exprs), varName, env) ||
-               containsName(std::get<3>(exprs), varName, env);
+        return fail("Only C-order .npy arrays are supported");
     }
 
-    if (auto list = dynamic_cast<ExpressionList*>(expr))
+    auto shape = npyField(header, "shape");
+    std::vector<size_t> dimensions{};
+    for (const char* p = shape.data(), *last = shape.data() + shape.size(); p < last; ++p)
     {
-        for (auto e : list->getVectorExpression())
+        size_t dimension = 0;
+        auto [next, ec] = std::from_chars(p, last, dimension);
+        if (ec == std::errc{})
         {
-            if (containsName(e, varName, env))
-            {
-                return true;
-            }
+            dimensions.push_back(dimension);
+            p = next;
         }
     }
+    if (dimensions.empty() || dimensions.size() > 2)
+    {
+        return fail("Only 1-D and 2-D .npy arrays are supported");
+    }
+    rows = (dimensions.size() == 2) ? dimensions[0] : 1;
+    columns = dimensions.back();
+    if (rows == 0 || columns == 0)
+    {
+        return fail("Empty matrix (0x0)");
+    }
+    // Divided rather than multiplied, so a huge shape cannot wrap around and pass
+    size_t offset = prefix + headerLength;
+    if (columns > (length - offset) / sizeof(double) / rows)
+    {
+        return fail("'" + path + "' is shorter than its shape");
+    }
+    if (offset % alignof(double) != 0)
+    {
+        // Writers pad the header to 64 bytes, data after any other header is copied to aligned memory
+        size_t count = rows * columns;
+        std::shared_ptr<double> copy(new (std::nothrow) double[count], std::default_delete<double[]>());
+        if (copy == nullptr)
+        {
+            return fail("Not enough memory to load '" + path + "'");
+        }
+        std::memcpy(copy.get(), base + offset, count * sizeof(double));
+        ::munmap(mapping, length);
+        data = copy;
+        return nullptr;
+    }
+
+    ::madvise(mapping, length, MADV_SEQUENTIAL);
+    data = std::shared_ptr<const double>(reinterpret_cast<const double*>(base + offset), [mapping, length](const double*) { ::munmap(mapping, length); });
+    return nullptr;
+}
 
-    return false;
+Expression* writeNpy(const std::string& path, const double* data, size_t rows, size_t columns) noexcept
+{
+    if (!littleEndianHost())
+    {
+        return new Invalid("Saving .npy files needs a little-endian host");
+    }
+    std::string header = "{'descr': '<f8', 'fortran_order': False, 'shape': (" + std::to_string(rows) + ", " + std::to_string(columns) + "), }";
+    // The data starts on a 64 byte boundary, the header is padded with spaces and ends in a newline
+    size_t total = ((10 + header.size() + 1 + 63) / 64) * 64;
+    header.append(total - 10 - header.size() - 1, ' ');
+    header += '\n';
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return new Invalid("Could not open file '" + path + "'");
+    }
+    unsigned char prefix[10] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0, static_cast<unsigned char>(header.size() & 0xff), static_cast<unsigned char>(header.size() >> 8)};
+    bool ok = std::fwrite(prefix, 1, sizeof(prefix), file) == sizeof(prefix) &&
+              std::fwrite(header.data(), 1, header.size(), file) == header.size() &&
+              std::fwrite(data, sizeof(double), rows * columns, file) == rows * columns;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok)
+    {
+        return new Invalid("Could not write file '" + path + "'");
+    }
+    return nullptr;
 }
\ No newline at end of file
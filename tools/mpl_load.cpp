@@ -0,0 +1,169 @@
+// Load generator for `mpl --serve`: sends the same script over several connections and reports
+// the throughput and the latency percentiles of the answers
+#include <atomic>
+#include <chrono>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <Server.hpp>
+
+using Clock = std::chrono::steady_clock;
+
+void usage(char* argv[])
+{
+    std::cout << "Usage: " << argv[0] << " [options] socket_path script_file" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --connections=N  parallel clients (default 8)" << std::endl;
+    std::cout << "  --requests=N     requests per client (default 1000)" << std::endl;
+    std::cout << "  --bind=name=v    number sent with every request, can be repeated" << std::endl;
+    exit(1);
+}
+
+size_t option_value(std::string_view arg, char* argv[])
+{
+    size_t value = 0;
+    auto text = arg.substr(arg.find('=') + 1);
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || ec != std::errc{} || end != text.data() + text.size())
+    {
+        usage(argv);
+    }
+    return value;
+}
+
+int connect_to(const std::string& path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t connections = 8;
+    size_t requests = 1000;
+    ServerRequest request{};
+    std::vector<char*> positional{};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        if (arg.rfind("--connections=", 0) == 0)
+        {
+            connections = std::max<size_t>(option_value(arg, argv), 1);
+        }
+        else if (arg.rfind("--requests=", 0) == 0)
+        {
+            requests = std::max<size_t>(option_value(arg, argv), 1);
+        }
+        else if (arg.rfind("--bind=", 0) == 0)
+        {
+            auto binding = arg.substr(7);
+            auto separator = binding.find('=');
+            double value = 0;
+            if (separator == std::string_view::npos ||
+                std::from_chars(binding.data() + separator + 1, binding.data() + binding.size(), value).ec != std::errc{})
+            {
+                usage(argv);
+            }
+            request.bindings.push_back(ServerBinding{std::string(binding.substr(0, separator)), {}, {value}});
+        }
+        else if (arg.size() > 1 && arg[0] == '-')
+        {
+            usage(argv);
+        }
+        else
+        {
+            positional.push_back(argv[i]);
+        }
+    }
+    if (positional.size() != 2)
+    {
+        usage(argv);
+    }
+
+    std::ifstream file(positional[1]);
+    if (!file)
+    {
+        std::cout << "Could not open " << positional[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::stringstream script;
+    script << file.rdbuf();
+    request.script = script.str();
+    std::string frame{};
+    encodeRequest(request, frame);
+
+    std::vector<std::vector<double>> latencies(connections);
+    std::atomic<size_t> failures{0};
+    std::string sample{};
+    std::vector<std::thread> clients{};
+    auto start = Clock::now();
+
+    for (size_t c = 0; c < connections; ++c)
+    {
+        clients.emplace_back([&, c]
+        {
+            int fd = connect_to(positional[0]);
+            if (fd < 0)
+            {
+                failures += requests;
+                return;
+            }
+            ServerResponse response{};
+            latencies[c].reserve(requests);
+            for (size_t r = 0; r < requests; ++r)
+            {
+                auto sent = Clock::now();
+                if (!writeAll(fd, frame) || !readResponse(fd, response))
+                {
+                    failures += requests - r;
+                    break;
+                }
+                latencies[c].push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent).count());
+                failures += (response.status != ServerStatus::Ok) ? 1 : 0;
+                if (c == 0 && r == 0)
+                {
+                    sample = response.output;
+                }
+            }
+            close(fd);
+        });
+    }
+    for (auto& client : clients)
+    {
+        client.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> all{};
+    for (const auto& client : latencies)
+    {
+        all.insert(all.end(), client.begin(), client.end());
+    }
+    if (all.empty())
+    {
+        std::cout << "No answers from " << positional[0] << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&all](double p) { return all[std::min(all.size() - 1, static_cast<size_t>(p * all.size()))]; };
+
+    std::cout << "First answer:\n" << sample;
+    std::cout << "Requests:    " << all.size() << " (" << failures.load() << " failed)" << std::endl;
+    std::cout << "Throughput:  " << all.size() / seconds << " requests/s" << std::endl;
+    std::cout << "Latency us:  p50 " << percentile(0.50) << "  p90 " << percentile(0.90) << "  p99 " << percentile(0.99)
+              << "  max " << all.back() << std::endl;
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}